@@ -0,0 +1,121 @@
+#ifndef BP_ITERATOR_H
+# define BP_ITERATOR_H
+
+# include <memory>
+# include <iterator>
+# include "_Bp_tree_node.hpp"
+
+namespace ft
+{
+	/*
+	** A (leaf, index) pair walking the leaf chain. Unlike the red-black tree
+	** iterators, these are invalidated by any insertion or erasure that
+	** touches their leaf, as values move inside and between leaves.
+	*/
+	template <class I, class Leaf>
+	class BPIterator
+	{
+	public:
+		typedef I								value_type;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef Leaf							leaf_type;
+		typedef ptrdiff_t						difference_type;
+		typedef I&								reference;
+		typedef const I&						const_reference;
+		typedef I*								pointer;
+		typedef const I*						const_pointer;
+
+		typedef BPIterator<I, Leaf>				iterator;
+		typedef BPIterator<const I, Leaf>		const_iterator;
+
+	private:
+		_Bp_leaf_base	*node;
+		size_t			index;
+
+	public:
+		BPIterator() : node(NULL), index(0) {}
+
+		BPIterator(_Bp_leaf_base *leaf, size_t index) : node(leaf), index(index) {}
+
+		BPIterator(BPIterator const &other) : node(other.node), index(other.index) {}
+
+		BPIterator	&operator=(BPIterator const &other)
+		{
+			node = other.node;
+			index = other.index;
+			return (*this);
+		}
+
+		operator	const_iterator() const
+		{
+			return (const_iterator(node, index));
+		}
+
+		_Bp_leaf_base	*base() const
+		{
+			return (node);
+		}
+
+		size_t	position() const
+		{
+			return (index);
+		}
+
+		reference	operator*() const
+		{
+			return (static_cast<leaf_type *>(node)->value(index));
+		}
+
+		pointer	operator->() const
+		{
+			return &(static_cast<leaf_type *>(node)->value(index));
+		}
+
+		BPIterator	&operator++()
+		{
+			if (++index >= node->count)
+			{
+				node = node->next;
+				index = 0;
+			}
+			return (*this);
+		}
+
+		BPIterator	operator++(int)
+		{
+			BPIterator	tmp(*this);
+			operator++();
+			return (tmp);
+		}
+
+		BPIterator	&operator--()
+		{
+			if (index == 0)
+			{
+				node = node->prev;
+				index = node->count;
+			}
+			--index;
+			return (*this);
+		}
+
+		BPIterator	operator--(int)
+		{
+			BPIterator	tmp(*this);
+			operator--();
+			return (tmp);
+		}
+
+		bool	operator==(BPIterator const &other) const
+		{
+			return (node == other.node && index == other.index);
+		}
+
+		bool	operator!=(BPIterator const &other) const
+		{
+			return (!(*this == other));
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,1261 @@
+#ifndef _BP_TREE_H
+# define _BP_TREE_H
+
+# include <new>
+# include <memory>
+# include <limits>
+# include "utilities.hpp"
+# include "pair.hpp"
+# include "_Bp_tree_node.hpp"
+# include "_Bp_iterator.hpp"
+# include "iterator_traits.hpp"
+
+namespace ft
+{
+	/*
+	** Builds, destroys and moves the slots of a node (see bp_slot). Only
+	** building may throw: moving copies either a value whose copy cannot
+	** throw or a pointer.
+	*/
+	template <class T, class Alloc, bool Inline = bp_inline<T>::value>
+	struct bp_slot_ops
+	{
+		typedef bp_slot<T, Inline>	slot_type;
+
+		static void	make(Alloc &alloc, slot_type *slot, const T &val)
+		{
+			alloc.construct(slot->get(), val);
+		}
+
+		template <class A1, class A2>
+		static void	make(Alloc &, slot_type *slot, const A1 &first, const A2 &second)
+		{
+			::new (static_cast<void *>(slot->get())) T(first, second);
+		}
+
+		static void	destroy(Alloc &alloc, slot_type *slot)
+		{
+			alloc.destroy(slot->get());
+		}
+
+		static void	relocate(Alloc &alloc, slot_type *to, slot_type *from)
+		{
+			alloc.construct(to->get(), *from->get());
+			alloc.destroy(from->get());
+		}
+	};
+
+	template <class T, class Alloc>
+	struct bp_slot_ops<T, Alloc, false>
+	{
+		typedef bp_slot<T, false>	slot_type;
+
+		static void	make(Alloc &alloc, slot_type *slot, const T &val)
+		{
+			T	*cell = alloc.allocate(1);
+
+			try
+			{
+				alloc.construct(cell, val);
+			}
+			catch (...)
+			{
+				alloc.deallocate(cell, 1);
+				throw ;
+			}
+			slot->cell = cell;
+		}
+
+		template <class A1, class A2>
+		static void	make(Alloc &alloc, slot_type *slot, const A1 &first, const A2 &second)
+		{
+			T	*cell = alloc.allocate(1);
+
+			try
+			{
+				::new (static_cast<void *>(cell)) T(first, second);
+			}
+			catch (...)
+			{
+				alloc.deallocate(cell, 1);
+				throw ;
+			}
+			slot->cell = cell;
+		}
+
+		static void	destroy(Alloc &alloc, slot_type *slot)
+		{
+			alloc.destroy(slot->cell);
+			alloc.deallocate(slot->cell, 1);
+		}
+
+		static void	relocate(Alloc &, slot_type *to, slot_type *from)
+		{
+			to->cell = from->cell;
+		}
+	};
+
+	/*
+	** B+tree with unique keys, the engine of btree_map and btree_set. Key,
+	** T, KeyOfValue and Compare play the same roles as in RBTree.
+	**
+	** Separators follow one rule: every key under children[i] is below
+	** key(i), itself not above any key under children[i + 1]. Erasing never
+	** has to touch them, and a key equal to a separator lives on its right.
+	** Nodes under half full borrow from or merge with a sibling on erase;
+	** inserts at either end of the tree split unevenly so that sorted loads
+	** leave full nodes behind.
+	**
+	** What may throw (allocating nodes, copying a value or a separator) is
+	** done before the tree is touched, and moving values and keys around
+	** cannot throw (see bp_inline): an insert or an erase that throws leaves
+	** the tree as it was.
+	*/
+	template <class Key, class T, class KeyOfValue, class Compare = std::less<Key>, class Allocator = std::allocator<T> >
+	class BPTree
+	{
+		public:
+			typedef Key															key_type;
+			typedef T															value_type;
+			typedef KeyOfValue													key_of_value;
+			typedef Compare														key_compare;
+			typedef Allocator													allocator_type;
+			typedef size_t														size_type;
+			typedef ptrdiff_t													difference_type;
+			typedef typename allocator_type::reference							reference;
+			typedef typename allocator_type::const_reference					const_reference;
+			typedef typename allocator_type::pointer							pointer;
+			typedef typename allocator_type::const_pointer						const_pointer;
+			typedef BPLeaf<value_type>											leaf_type;
+			typedef BPInner<key_type>											inner_type;
+			typedef BPIterator<value_type, leaf_type>							iterator;
+			typedef BPIterator<const value_type, leaf_type>						const_iterator;
+			typedef ft::reverse_iterator<iterator>								reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
+			typedef typename Allocator::template rebind<bp_cache_line>::other	line_allocator;
+			typedef typename Allocator::template rebind<key_type>::other		key_allocator;
+
+		private:
+			typedef typename leaf_type::slot_type								value_slot;
+			typedef typename inner_type::slot_type								key_slot;
+			typedef bp_slot_ops<value_type, allocator_type>						value_ops;
+			typedef bp_slot_ops<key_type, key_allocator>						key_ops;
+
+			/*
+			** What an insert needs before it can start moving things: the
+			** nodes its splits will take (spare inners are chained through
+			** parent) and the separator the split leaf hands up.
+			*/
+			struct insert_plan
+			{
+				leaf_type		*leaf;
+				_Bp_node_base	*inners;
+				key_slot		sep;
+				bool			has_sep;
+
+				insert_plan() : leaf(NULL), inners(NULL), has_sep(false) {}
+			};
+
+		public:
+			/****************************************************************************\
+			**								Member functions							**
+			\****************************************************************************/
+
+			explicit BPTree(const key_compare &comp, const allocator_type &alloc)
+				: _comp(comp), _root(NULL), _lines(alloc), _alloc(alloc), _alloc_key(alloc), _size(0)
+			{
+				reset_header();
+			}
+
+			BPTree(const BPTree &other)
+				: _comp(other._comp), _root(NULL), _lines(other._alloc), _alloc(other._alloc), _alloc_key(other._alloc), _size(0)
+			{
+				reset_header();
+				clone_tree(other);
+			}
+
+			/*
+			** Copies the tree node for node: no comparison, no split. The copy
+			** is built aside and swapped in, so a value that fails to copy
+			** leaves the tree as it was.
+			*/
+			BPTree	&operator=(const BPTree &other)
+			{
+				if (this != &other)
+				{
+					BPTree	copy(other._comp, other._alloc);
+
+					copy.clone_tree(other);
+					swap(copy);
+				}
+				return (*this);
+			}
+
+			~BPTree()
+			{
+				clear();
+			}
+
+			allocator_type	get_allocator() const
+			{
+				return (_alloc);
+			}
+
+			/****************************************************************************\
+			**									Iterators								**
+			\****************************************************************************/
+
+			iterator	begin()
+			{
+				return (iterator(_header.next, 0));
+			}
+
+			const_iterator	begin() const
+			{
+				return (const_iterator(_header.next, 0));
+			}
+
+			iterator	end()
+			{
+				return (iterator(&_header, 0));
+			}
+
+			const_iterator	end() const
+			{
+				return (const_iterator(const_cast<_Bp_leaf_base *>(&_header), 0));
+			}
+
+			reverse_iterator	rbegin()
+			{
+				return (reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rbegin() const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			reverse_iterator	rend()
+			{
+				return (reverse_iterator(begin()));
+			}
+
+			const_reverse_iterator	rend() const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			/****************************************************************************\
+			**									Capacity								**
+			\****************************************************************************/
+
+			bool	empty() const
+			{
+				return (!_size);
+			}
+
+			size_type	size() const
+			{
+				return (_size);
+			}
+
+			size_type	max_size() const { return std::min<size_type>(_alloc.max_size(),
+									std::numeric_limits<difference_type>::max()); }
+
+			/****************************************************************************\
+			**									Modifiers								**
+			\****************************************************************************/
+
+			void	clear()
+			{
+				if (_root)
+					destroy_node(_root);
+				_root = NULL;
+				reset_header();
+				_size = 0;
+			}
+
+			ft::pair<iterator, bool>	insert(const value_type &data)
+			{
+				leaf_type	*leaf;
+				size_type	pos;
+
+				if (find_insert_pos(key_of_value()(data), leaf, pos))
+					return (ft::make_pair(iterator(leaf, pos), false));
+				return (ft::make_pair(insert_at(leaf, pos, data), true));
+			}
+
+			/*
+			** The hint is taken when data goes right before it and right after
+			** its predecessor in the same leaf, or past the last element; any
+			** other position needs the separators above and is searched for.
+			*/
+			iterator	insert(const_iterator hint, const value_type &data)
+			{
+				const key_type	&k = key_of_value()(data);
+				leaf_type		*leaf = static_cast<leaf_type *>(hint.base());
+				size_type		pos = hint.position();
+
+				if (leaf == &_header && _root)
+				{
+					leaf = static_cast<leaf_type *>(_header.prev);
+					pos = leaf->count;
+				}
+				if (_root && pos > 0 && _comp(key(leaf, pos - 1), k)
+					&& (pos == leaf->count ? leaf->next == &_header : _comp(k, key(leaf, pos))))
+					return (insert_at(leaf, pos, data));
+				return (insert(data).first);
+			}
+
+			template <class InputIt>
+			void	insert(InputIt first, InputIt last,
+				typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+			{
+				while (first != last)
+					insert(end(), *first++);
+			}
+
+			/*
+			** Single-descent building blocks for try_emplace() and the like:
+			** find_insert_pos() returns true and the slot of k when k is there,
+			** or false and the slot it would go to; emplace_at() then builds
+			** value_type(first, second) there.
+			*/
+			template <class K>
+			bool	find_insert_pos(const K &k, leaf_type *&leaf, size_type &pos) const
+			{
+				leaf = NULL;
+				pos = 0;
+				if (!_root)
+					return (false);
+				leaf = descend(k);
+				pos = lower_index(leaf, k);
+				return (pos < leaf->count && !_comp(k, key(leaf, pos)));
+			}
+
+			/*
+			** The value is built before anything moves, so the arguments may
+			** refer to elements of the tree.
+			*/
+			iterator	insert_at(leaf_type *leaf, size_type pos, const value_type &data)
+			{
+				value_slot	val;
+
+				value_ops::make(_alloc, &val, data);
+				return (place_at(leaf, pos, val));
+			}
+
+			template <class A1, class A2>
+			iterator	emplace_at(leaf_type *leaf, size_type pos, const A1 &first, const A2 &second)
+			{
+				value_slot	val;
+
+				value_ops::make(_alloc, &val, first, second);
+				return (place_at(leaf, pos, val));
+			}
+
+			/*
+			** Returns the element that followed pos. Values shift inside the
+			** leaf and may move to a sibling when the leaf has to borrow or
+			** merge; the returned iterator accounts for that.
+			*/
+			iterator	erase(const_iterator pos)
+			{
+				leaf_type	*leaf = static_cast<leaf_type *>(pos.base());
+				size_type	i = pos.position();
+				int			side = 0;
+				key_slot	sep;
+
+				if (leaf != _root && leaf->count <= _leaf_min)
+					side = borrow_side(leaf, sep);
+				value_ops::destroy(_alloc, leaf->slot(i));
+				for (size_type j = i + 1; j < leaf->count; ++j)
+					relocate(leaf->slot(j - 1), leaf->slot(j));
+				--leaf->count;
+				--_size;
+				if (leaf == _root)
+				{
+					if (!leaf->count)
+					{
+						free_node(leaf);
+						_root = NULL;
+						reset_header();
+						return (end());
+					}
+				}
+				else if (leaf->count < _leaf_min)
+					rebalance_leaf(leaf, i, side, sep);
+				if (i == leaf->count)
+					return (iterator(leaf->next, 0));
+				return (iterator(leaf, i));
+			}
+
+			iterator	erase(iterator pos)
+			{
+				return (erase(const_iterator(pos)));
+			}
+
+			/*
+			** Erasures move values around, so last cannot be held on to: the
+			** range is counted first and erased element by element.
+			*/
+			iterator	erase(const_iterator first, const_iterator last)
+			{
+				if (first == begin() && last == end())
+				{
+					clear();
+					return (end());
+				}
+
+				size_type	n = 0;
+				iterator	it(first.base(), first.position());
+
+				for (const_iterator tmp = first; tmp != last; ++tmp)
+					++n;
+				while (n--)
+					it = erase(it);
+				return (it);
+			}
+
+			iterator	erase(iterator first, iterator last)
+			{
+				return (erase(const_iterator(first), const_iterator(last)));
+			}
+
+			template <class K>
+			size_type	erase(const K &k)
+			{
+				iterator	it = find(k);
+
+				if (it == end())
+					return (0);
+				erase(it);
+				return (1);
+			}
+
+			void	swap(BPTree &x)
+			{
+				ft::swap_elements(_comp, x._comp);
+				ft::swap_elements(_root, x._root);
+				ft::swap_elements(_header, x._header);
+				ft::swap_elements(_lines, x._lines);
+				ft::swap_elements(_alloc, x._alloc);
+				ft::swap_elements(_alloc_key, x._alloc_key);
+				ft::swap_elements(_size, x._size);
+				relink_header();
+				x.relink_header();
+			}
+
+			/****************************************************************************\
+			**									Lookup									**
+			\****************************************************************************/
+
+			template <class K>
+			iterator	find(const K &k)
+			{
+				leaf_type	*leaf;
+				size_type	pos;
+
+				if (!find_insert_pos(k, leaf, pos))
+					return (end());
+				return (iterator(leaf, pos));
+			}
+
+			template <class K>
+			const_iterator	find(const K &k) const
+			{
+				leaf_type	*leaf;
+				size_type	pos;
+
+				if (!find_insert_pos(k, leaf, pos))
+					return (end());
+				return (const_iterator(leaf, pos));
+			}
+
+			template <class K>
+			iterator	lower_bound(const K &k)
+			{
+				if (!_root)
+					return (end());
+
+				leaf_type	*leaf = descend(k);
+
+				return (make_iterator(leaf, lower_index(leaf, k)));
+			}
+
+			template <class K>
+			const_iterator	lower_bound(const K &k) const
+			{
+				return (const_cast<BPTree *>(this)->lower_bound(k));
+			}
+
+			template <class K>
+			iterator	upper_bound(const K &k)
+			{
+				if (!_root)
+					return (end());
+
+				leaf_type	*leaf = descend(k);
+
+				return (make_iterator(leaf, upper_index(leaf, k)));
+			}
+
+			template <class K>
+			const_iterator	upper_bound(const K &k) const
+			{
+				return (const_cast<BPTree *>(this)->upper_bound(k));
+			}
+
+			template <class K>
+			ft::pair<iterator, iterator>	equal_range(const K &k)
+			{
+				iterator	first = lower_bound(k);
+				iterator	last = first;
+
+				if (first != end() && !_comp(k, key_of_value()(*first)))
+					++last;
+				return (ft::make_pair(first, last));
+			}
+
+			template <class K>
+			ft::pair<const_iterator, const_iterator>	equal_range(const K &k) const
+			{
+				ft::pair<iterator, iterator>	range = const_cast<BPTree *>(this)->equal_range(k);
+
+				return (ft::make_pair(const_iterator(range.first), const_iterator(range.second)));
+			}
+
+		private:
+			/****************************************************************************\
+			**										Node								**
+			\****************************************************************************/
+
+			static const size_type	_leaf_min = leaf_type::capacity / 2;
+			static const size_type	_inner_min = inner_type::capacity / 2;
+
+			static size_type	lines_for(size_type bytes)
+			{
+				return ((bytes + sizeof(bp_cache_line) - 1) / sizeof(bp_cache_line));
+			}
+
+			leaf_type	*new_leaf()
+			{
+				leaf_type	*leaf = ::new (static_cast<void *>(_lines.allocate(lines_for(sizeof(leaf_type))))) leaf_type;
+
+				leaf->parent = NULL;
+				leaf->position = 0;
+				leaf->count = 0;
+				leaf->leaf = true;
+				leaf->prev = NULL;
+				leaf->next = NULL;
+				return (leaf);
+			}
+
+			inner_type	*new_inner()
+			{
+				inner_type	*inner = ::new (static_cast<void *>(_lines.allocate(lines_for(sizeof(inner_type))))) inner_type;
+
+				inner->parent = NULL;
+				inner->position = 0;
+				inner->count = 0;
+				inner->leaf = false;
+				return (inner);
+			}
+
+			/*
+			** Gives the storage back; the values or keys must be gone already.
+			*/
+			void	free_node(_Bp_node_base *node)
+			{
+				if (node->leaf)
+					_lines.deallocate(reinterpret_cast<bp_cache_line *>(node), lines_for(sizeof(leaf_type)));
+				else
+					_lines.deallocate(reinterpret_cast<bp_cache_line *>(node), lines_for(sizeof(inner_type)));
+			}
+
+			void	destroy_node(_Bp_node_base *node)
+			{
+				if (node->leaf)
+				{
+					leaf_type	*leaf = static_cast<leaf_type *>(node);
+
+					for (size_type i = 0; i < leaf->count; ++i)
+						value_ops::destroy(_alloc, leaf->slot(i));
+				}
+				else
+				{
+					inner_type	*inner = static_cast<inner_type *>(node);
+
+					for (size_type i = 0; i < inner->count; ++i)
+						destroy_node(inner->children[i]);
+					for (size_type i = 0; i + 1 < inner->count; ++i)
+						key_ops::destroy(_alloc_key, inner->key_slot(i));
+				}
+				free_node(node);
+			}
+
+			/*
+			** Fills an empty tree with a copy of other. On a throw the tree
+			** keeps no node and is left empty.
+			*/
+			void	clone_tree(const BPTree &other)
+			{
+				if (!other._root)
+					return ;
+
+				_Bp_leaf_base	*last = &_header;
+
+				_root = clone_node(other._root, NULL, last);
+				last->next = &_header;
+				_header.prev = last;
+				_size = other._size;
+			}
+
+			/*
+			** last is the last leaf copied so far; the leaves are chained after
+			** it as they come, which is in key order. A copy that throws frees
+			** the part of the subtree already built.
+			*/
+			_Bp_node_base	*clone_node(const _Bp_node_base *src, _Bp_node_base *parent, _Bp_leaf_base *&last)
+			{
+				if (src->leaf)
+				{
+					leaf_type	*from = static_cast<leaf_type *>(const_cast<_Bp_node_base *>(src));
+					leaf_type	*leaf = new_leaf();
+
+					try
+					{
+						for (; leaf->count < from->count; ++leaf->count)
+							value_ops::make(_alloc, leaf->slot(leaf->count), from->value(leaf->count));
+					}
+					catch (...)
+					{
+						destroy_node(leaf);
+						throw ;
+					}
+					leaf->parent = parent;
+					leaf->position = src->position;
+					leaf->prev = last;
+					last->next = leaf;
+					last = leaf;
+					return (leaf);
+				}
+
+				inner_type	*from = static_cast<inner_type *>(const_cast<_Bp_node_base *>(src));
+				inner_type	*inner = new_inner();
+
+				inner->parent = parent;
+				inner->position = src->position;
+				try
+				{
+					for (; inner->count < from->count; ++inner->count)
+					{
+						size_type		i = inner->count;
+						_Bp_node_base	*child = clone_node(from->children[i], inner, last);
+
+						inner->children[i] = child;
+						if (i + 1 < from->count)
+						{
+							try
+							{
+								key_ops::make(_alloc_key, inner->key_slot(i), from->key(i));
+							}
+							catch (...)
+							{
+								destroy_node(child);
+								throw ;
+							}
+						}
+					}
+				}
+				catch (...)
+				{
+					if (inner->count)
+						key_ops::destroy(_alloc_key, inner->key_slot(inner->count - 1));
+					destroy_node(inner);
+					throw ;
+				}
+				return (inner);
+			}
+
+			void	reset_header()
+			{
+				_header.parent = NULL;
+				_header.position = 0;
+				_header.count = 0;
+				_header.leaf = true;
+				_header.prev = &_header;
+				_header.next = &_header;
+			}
+
+			/*
+			** After the headers of two trees were exchanged, the first and last
+			** leaves still point at the old one.
+			*/
+			void	relink_header()
+			{
+				if (!_root)
+				{
+					reset_header();
+					return ;
+				}
+				_header.next->prev = &_header;
+				_header.prev->next = &_header;
+			}
+
+			void	relocate(value_slot *to, value_slot *from)
+			{
+				value_ops::relocate(_alloc, to, from);
+			}
+
+			void	relocate_key(key_slot *to, key_slot *from)
+			{
+				key_ops::relocate(_alloc_key, to, from);
+			}
+
+			void	set_child(inner_type *inner, size_type i, _Bp_node_base *child)
+			{
+				inner->children[i] = child;
+				child->parent = inner;
+				child->position = static_cast<unsigned short>(i);
+			}
+
+			/****************************************************************************\
+			**									Search									**
+			\****************************************************************************/
+
+			static const key_type	&key(leaf_type *leaf, size_type i)
+			{
+				return (key_of_value()(leaf->value(i)));
+			}
+
+			/*
+			** Index of the child of inner that may hold k: the number of
+			** separators not above k.
+			*/
+			template <class K>
+			size_type	child_index(inner_type *inner, const K &k) const
+			{
+				size_type	low = 0;
+				size_type	high = inner->count - 1;
+
+				while (low < high)
+				{
+					size_type	mid = low + (high - low) / 2;
+
+					if (_comp(k, inner->key(mid)))
+						high = mid;
+					else
+						low = mid + 1;
+				}
+				return (low);
+			}
+
+			template <class K>
+			leaf_type	*descend(const K &k) const
+			{
+				_Bp_node_base	*node = _root;
+
+				while (!node->leaf)
+				{
+					inner_type	*inner = static_cast<inner_type *>(node);
+
+					node = inner->children[child_index(inner, k)];
+				}
+				return (static_cast<leaf_type *>(node));
+			}
+
+			template <class K>
+			size_type	lower_index(leaf_type *leaf, const K &k) const
+			{
+				size_type	low = 0;
+				size_type	high = leaf->count;
+
+				while (low < high)
+				{
+					size_type	mid = low + (high - low) / 2;
+
+					if (_comp(key(leaf, mid), k))
+						low = mid + 1;
+					else
+						high = mid;
+				}
+				return (low);
+			}
+
+			template <class K>
+			size_type	upper_index(leaf_type *leaf, const K &k) const
+			{
+				size_type	low = 0;
+				size_type	high = leaf->count;
+
+				while (low < high)
+				{
+					size_type	mid = low + (high - low) / 2;
+
+					if (_comp(k, key(leaf, mid)))
+						high = mid;
+					else
+						low = mid + 1;
+				}
+				return (low);
+			}
+
+			/*
+			** An index one past the end of a leaf is the first slot of the next.
+			*/
+			iterator	make_iterator(leaf_type *leaf, size_type i)
+			{
+				if (i == leaf->count)
+					return (iterator(leaf->next, 0));
+				return (iterator(leaf, i));
+			}
+
+			/****************************************************************************\
+			**									Insertion								**
+			\****************************************************************************/
+
+			bool	is_leftmost(const _Bp_node_base *node) const
+			{
+				for (; node->parent; node = node->parent)
+					if (node->position != 0)
+						return (false);
+				return (true);
+			}
+
+			bool	is_rightmost(const _Bp_node_base *node) const
+			{
+				for (; node->parent; node = node->parent)
+					if (node->position + 1 != node->parent->count)
+						return (false);
+				return (true);
+			}
+
+			/*
+			** Where a full leaf splits: evenly, unless the new value goes past
+			** the end of the last leaf or before the start of the first one,
+			** where the old leaf is kept as full as possible. The hole at pos
+			** always lands in a leaf with room, and never at the front of the
+			** new one, so the first value of the new leaf can serve as the
+			** separator.
+			*/
+			size_type	leaf_split(leaf_type *leaf, size_type pos) const
+			{
+				if (pos == leaf->count && leaf->next == &_header)
+					return (leaf->count - 1);
+				if (pos == 0 && leaf->prev == &_header)
+					return (1);
+				return (leaf->count / 2);
+			}
+
+			/*
+			** Gets the nodes and the separator an insert at pos in leaf will
+			** need: a leaf for an empty tree; for a full leaf, a leaf, an inner
+			** for each full ancestor and one more for a new root if they all
+			** are. Nothing is kept if this throws.
+			*/
+			void	prepare_insert(leaf_type *leaf, size_type pos, insert_plan &plan)
+			{
+				if (!_root)
+				{
+					plan.leaf = new_leaf();
+					return ;
+				}
+				if (leaf->count < leaf_type::capacity)
+					return ;
+				try
+				{
+					_Bp_node_base	*node = leaf->parent;
+
+					plan.leaf = new_leaf();
+					for (; node && node->count == inner_type::capacity; node = node->parent)
+						push_inner(plan);
+					if (!node)
+						push_inner(plan);
+					key_ops::make(_alloc_key, &plan.sep, key(leaf, leaf_split(leaf, pos)));
+					plan.has_sep = true;
+				}
+				catch (...)
+				{
+					release(plan);
+					throw ;
+				}
+			}
+
+			void	push_inner(insert_plan &plan)
+			{
+				inner_type	*inner = new_inner();
+
+				inner->parent = plan.inners;
+				plan.inners = inner;
+			}
+
+			inner_type	*take_inner(insert_plan &plan)
+			{
+				inner_type	*inner = static_cast<inner_type *>(plan.inners);
+
+				plan.inners = inner->parent;
+				inner->parent = NULL;
+				return (inner);
+			}
+
+			void	release(insert_plan &plan)
+			{
+				if (plan.has_sep)
+					key_ops::destroy(_alloc_key, &plan.sep);
+				if (plan.leaf)
+					free_node(plan.leaf);
+				while (plan.inners)
+					free_node(take_inner(plan));
+			}
+
+			/*
+			** Moves the value built in val to pos in leaf. Past
+			** prepare_insert(), nothing can throw.
+			*/
+			iterator	place_at(leaf_type *leaf, size_type pos, value_slot &val)
+			{
+				insert_plan	plan;
+
+				try
+				{
+					prepare_insert(leaf, pos, plan);
+				}
+				catch (...)
+				{
+					value_ops::destroy(_alloc, &val);
+					throw ;
+				}
+				leaf = open_slot(leaf, pos, plan);
+				relocate(leaf->slot(pos), &val);
+				++leaf->count;
+				++_size;
+				return (iterator(leaf, pos));
+			}
+
+			/*
+			** Makes room for one value at pos in leaf, splitting it when it is
+			** full, and returns the leaf the hole ended up in (pos follows).
+			** The caller fills the slot and bumps the count. An empty tree is
+			** given a root leaf first.
+			*/
+			leaf_type	*open_slot(leaf_type *leaf, size_type &pos, insert_plan &plan)
+			{
+				if (!_root)
+				{
+					leaf = plan.leaf;
+					leaf->prev = &_header;
+					leaf->next = &_header;
+					_header.prev = leaf;
+					_header.next = leaf;
+					_root = leaf;
+					pos = 0;
+					return (leaf);
+				}
+				if (leaf->count == leaf_type::capacity)
+				{
+					leaf_type	*right = split_leaf(leaf, pos, plan);
+
+					if (pos > leaf->count)
+					{
+						pos -= leaf->count;
+						leaf = right;
+					}
+				}
+				for (size_type j = leaf->count; j > pos; --j)
+					relocate(leaf->slot(j), leaf->slot(j - 1));
+				return (leaf);
+			}
+
+			/*
+			** Moves the upper part of a full leaf to a new right sibling (see
+			** leaf_split()).
+			*/
+			leaf_type	*split_leaf(leaf_type *leaf, size_type pos, insert_plan &plan)
+			{
+				leaf_type	*right = plan.leaf;
+				size_type	keep = leaf_split(leaf, pos);
+
+				for (size_type j = keep; j < leaf->count; ++j)
+					relocate(right->slot(j - keep), leaf->slot(j));
+				right->count = leaf->count - keep;
+				leaf->count = keep;
+				right->prev = leaf;
+				right->next = leaf->next;
+				leaf->next->prev = right;
+				leaf->next = right;
+				insert_child(leaf, right, plan.sep, plan);
+				return (right);
+			}
+
+			/*
+			** Hangs right as the next sibling of node, with sep moved between
+			** the two.
+			*/
+			void	insert_child(_Bp_node_base *node, _Bp_node_base *right, key_slot &sep, insert_plan &plan)
+			{
+				if (!node->parent)
+				{
+					inner_type	*root = take_inner(plan);
+
+					set_child(root, 0, node);
+					set_child(root, 1, right);
+					relocate_key(root->key_slot(0), &sep);
+					root->count = 2;
+					_root = root;
+					return ;
+				}
+
+				inner_type	*inner = static_cast<inner_type *>(node->parent);
+				size_type	j = node->position + 1;
+
+				if (inner->count == inner_type::capacity)
+					inner = split_inner(inner, j, plan);
+				for (size_type i = inner->count; i > j; --i)
+				{
+					set_child(inner, i, inner->children[i - 1]);
+					relocate_key(inner->key_slot(i - 1), inner->key_slot(i - 2));
+				}
+				set_child(inner, j, right);
+				relocate_key(inner->key_slot(j - 1), &sep);
+				++inner->count;
+			}
+
+			/*
+			** Same as split_leaf() one level up: the separator between the two
+			** halves moves up to the parent. j, the slot of the child about to
+			** be added, decides the half that gets it and is updated.
+			*/
+			inner_type	*split_inner(inner_type *inner, size_type &j, insert_plan &plan)
+			{
+				inner_type	*right = take_inner(plan);
+				size_type	keep = inner->count / 2;
+				key_slot	sep;
+
+				if (j == inner->count && is_rightmost(inner))
+					keep = inner->count - 1;
+				else if (j == 1 && is_leftmost(inner))
+					keep = 1;
+				for (size_type i = keep; i < inner->count; ++i)
+				{
+					set_child(right, i - keep, inner->children[i]);
+					if (i + 1 < inner->count)
+						relocate_key(right->key_slot(i - keep), inner->key_slot(i));
+				}
+				right->count = inner->count - keep;
+				inner->count = keep;
+				relocate_key(&sep, inner->key_slot(keep - 1));
+				insert_child(inner, right, sep, plan);
+				if (j > keep)
+				{
+					j -= keep;
+					return (right);
+				}
+				return (inner);
+			}
+
+			/****************************************************************************\
+			**									Erasure									**
+			\****************************************************************************/
+
+			/*
+			** Removes children[j] (j > 0) and the separator on its left.
+			*/
+			void	remove_child(inner_type *inner, size_type j)
+			{
+				key_ops::destroy(_alloc_key, inner->key_slot(j - 1));
+				unhook_child(inner, j);
+			}
+
+			/*
+			** Same, with the separator already moved out.
+			*/
+			void	unhook_child(inner_type *inner, size_type j)
+			{
+				for (size_type i = j; i + 1 < inner->count; ++i)
+				{
+					set_child(inner, i, inner->children[i + 1]);
+					relocate_key(inner->key_slot(i - 1), inner->key_slot(i));
+				}
+				--inner->count;
+			}
+
+			/*
+			** Appends right to its left sibling left and frees it.
+			*/
+			void	merge_leaves(leaf_type *left, leaf_type *right)
+			{
+				for (size_type j = 0; j < right->count; ++j)
+					relocate(left->slot(left->count + j), right->slot(j));
+				left->count += right->count;
+				left->next = right->next;
+				right->next->prev = left;
+				remove_child(static_cast<inner_type *>(right->parent), right->position);
+				free_node(right);
+			}
+
+			/*
+			** Decides, before leaf loses a value and falls under half full,
+			** whether it will borrow from its left sibling (-1), its right one
+			** (1) or merge (0). A borrow changes the separator above the two
+			** leaves: its copy is made here, while nothing has moved yet.
+			*/
+			int	borrow_side(leaf_type *leaf, key_slot &sep)
+			{
+				inner_type	*parent = static_cast<inner_type *>(leaf->parent);
+				size_type	p = leaf->position;
+				leaf_type	*left = p > 0 ? static_cast<leaf_type *>(parent->children[p - 1]) : NULL;
+				leaf_type	*right = p + 1 < parent->count ? static_cast<leaf_type *>(parent->children[p + 1]) : NULL;
+
+				if (left && left->count > _leaf_min)
+				{
+					key_ops::make(_alloc_key, &sep, key(left, left->count - 1));
+					return (-1);
+				}
+				if (right && right->count > _leaf_min)
+				{
+					key_ops::make(_alloc_key, &sep, key(right, 1));
+					return (1);
+				}
+				return (0);
+			}
+
+			/*
+			** leaf fell under half full; (leaf, i) is the slot that followed the
+			** erased value and is kept pointing at the same element. side and
+			** sep come from borrow_side().
+			*/
+			void	rebalance_leaf(leaf_type *&leaf, size_type &i, int side, key_slot &sep)
+			{
+				inner_type	*parent = static_cast<inner_type *>(leaf->parent);
+				size_type	p = leaf->position;
+				leaf_type	*left = p > 0 ? static_cast<leaf_type *>(parent->children[p - 1]) : NULL;
+				leaf_type	*right = p + 1 < parent->count ? static_cast<leaf_type *>(parent->children[p + 1]) : NULL;
+
+				if (side < 0)
+				{
+					for (size_type j = leaf->count; j > 0; --j)
+						relocate(leaf->slot(j), leaf->slot(j - 1));
+					relocate(leaf->slot(0), left->slot(--left->count));
+					++leaf->count;
+					key_ops::destroy(_alloc_key, parent->key_slot(p - 1));
+					relocate_key(parent->key_slot(p - 1), &sep);
+					++i;
+				}
+				else if (side > 0)
+				{
+					relocate(leaf->slot(leaf->count++), right->slot(0));
+					for (size_type j = 1; j < right->count; ++j)
+						relocate(right->slot(j - 1), right->slot(j));
+					--right->count;
+					key_ops::destroy(_alloc_key, parent->key_slot(p));
+					relocate_key(parent->key_slot(p), &sep);
+				}
+				else
+				{
+					if (left)
+					{
+						i += left->count;
+						merge_leaves(left, leaf);
+						leaf = left;
+					}
+					else
+						merge_leaves(leaf, right);
+					rebalance_inner(parent);
+				}
+			}
+
+			/*
+			** Separators only move here: the one above two inner siblings is
+			** rotated through the parent, or pulled down when they merge.
+			*/
+			void	rebalance_inner(inner_type *node)
+			{
+				if (node == _root)
+				{
+					if (node->count == 1)
+					{
+						_root = node->children[0];
+						_root->parent = NULL;
+						_root->position = 0;
+						free_node(node);
+					}
+					return ;
+				}
+				if (node->count >= _inner_min)
+					return ;
+
+				inner_type	*parent = static_cast<inner_type *>(node->parent);
+				size_type	p = node->position;
+				inner_type	*left = p > 0 ? static_cast<inner_type *>(parent->children[p - 1]) : NULL;
+				inner_type	*right = p + 1 < parent->count ? static_cast<inner_type *>(parent->children[p + 1]) : NULL;
+
+				if (left && left->count > _inner_min)
+				{
+					for (size_type i = node->count; i > 0; --i)
+					{
+						set_child(node, i, node->children[i - 1]);
+						if (i < node->count)
+							relocate_key(node->key_slot(i), node->key_slot(i - 1));
+					}
+					set_child(node, 0, left->children[left->count - 1]);
+					relocate_key(node->key_slot(0), parent->key_slot(p - 1));
+					relocate_key(parent->key_slot(p - 1), left->key_slot(left->count - 2));
+					--left->count;
+					++node->count;
+				}
+				else if (right && right->count > _inner_min)
+				{
+					set_child(node, node->count, right->children[0]);
+					relocate_key(node->key_slot(node->count - 1), parent->key_slot(p));
+					++node->count;
+					relocate_key(parent->key_slot(p), right->key_slot(0));
+					for (size_type i = 1; i < right->count; ++i)
+					{
+						set_child(right, i - 1, right->children[i]);
+						if (i + 1 < right->count)
+							relocate_key(right->key_slot(i - 1), right->key_slot(i));
+					}
+					--right->count;
+				}
+				else
+				{
+					if (left)
+						merge_inners(left, node);
+					else
+						merge_inners(node, right);
+					rebalance_inner(parent);
+				}
+			}
+
+			/*
+			** Pulls the separator of the two siblings down between them.
+			*/
+			void	merge_inners(inner_type *left, inner_type *right)
+			{
+				inner_type	*parent = static_cast<inner_type *>(left->parent);
+
+				relocate_key(left->key_slot(left->count - 1), parent->key_slot(left->position));
+				for (size_type i = 0; i < right->count; ++i)
+				{
+					set_child(left, left->count + i, right->children[i]);
+					if (i + 1 < right->count)
+						relocate_key(left->key_slot(left->count + i), right->key_slot(i));
+				}
+				left->count += right->count;
+				unhook_child(parent, right->position);
+				free_node(right);
+			}
+
+		private:
+			key_compare		_comp;
+			_Bp_node_base	*_root;
+			_Bp_leaf_base	_header;
+			line_allocator	_lines;
+			allocator_type	_alloc;
+			key_allocator	_alloc_key;
+			size_type		_size;
+	};
+}
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef _BP_TREE_NODE_H
+# define _BP_TREE_NODE_H
+
+# include <cstddef>
+# include <type_traits>
+# include "pair.hpp"
+
+namespace ft {
+
+	/*
+	** Nodes of the B+tree behind btree_map and btree_set. Values only live in
+	** the leaves, which are chained in key order; inner nodes hold children
+	** and copies of the separating keys. Slot counts are chosen so that a
+	** node fills bp_node_bytes (four cache lines), and the tree allocates
+	** nodes as whole cache lines.
+	*/
+	static const size_t	bp_node_bytes = 256;
+
+	struct bp_cache_line
+	{
+		unsigned char	bytes[64];
+	};
+
+	/*
+	** count is the number of values in a leaf and the number of children in
+	** an inner node; position is the node's index among its parent's
+	** children.
+	*/
+	struct _Bp_node_base
+	{
+		_Bp_node_base	*parent;
+		unsigned short	position;
+		unsigned short	count;
+		bool			leaf;
+	};
+
+	/*
+	** The leaf chain is circular through a header owned by the tree, whose
+	** count stays 0: it is what end() points at.
+	*/
+	struct _Bp_leaf_base : public _Bp_node_base
+	{
+		_Bp_leaf_base	*prev;
+		_Bp_leaf_base	*next;
+	};
+
+	/*
+	** Values and keys whose copy cannot throw live in the nodes and are
+	** moved around by copying them. The others live out of line, one
+	** allocation each, so that moving one inside or between nodes copies a
+	** pointer and cannot fail. ft::pair is looked through, as its copy
+	** constructor is not declared noexcept.
+	*/
+	template <class T>
+	struct bp_inline
+	{
+		static const bool	value = std::is_nothrow_copy_constructible<T>::value;
+	};
+
+	template <class T1, class T2>
+	struct bp_inline<ft::pair<T1, T2> >
+	{
+		static const bool	value = bp_inline<T1>::value && bp_inline<T2>::value;
+	};
+
+	/*
+	** One value or key of a node: raw storage for it, or a pointer to it.
+	*/
+	template <class T, bool Inline = bp_inline<T>::value>
+	struct bp_slot
+	{
+		typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type	storage;
+
+		T	*get() { return (reinterpret_cast<T *>(&storage)); }
+	};
+
+	template <class T>
+	struct bp_slot<T, false>
+	{
+		T	*cell;
+
+		T	*get() { return (cell); }
+	};
+
+	template <class T>
+	struct bp_leaf_capacity
+	{
+		static const size_t	fit = (bp_node_bytes - sizeof(_Bp_leaf_base)) / sizeof(bp_slot<T>);
+		static const size_t	value = fit < 3 ? 3 : fit;
+	};
+
+	/*
+	** n children take n pointers and n - 1 keys.
+	*/
+	template <class Key>
+	struct bp_inner_capacity
+	{
+		static const size_t	fit = (bp_node_bytes - sizeof(_Bp_node_base) + sizeof(bp_slot<Key>)) / (sizeof(void *) + sizeof(bp_slot<Key>));
+		static const size_t	value = fit < 4 ? 4 : fit;
+	};
+
+	/*
+	** Only the first count slots hold a value.
+	*/
+	template <class T>
+	struct BPLeaf : public _Bp_leaf_base
+	{
+		typedef T				value_type;
+		typedef bp_slot<T>		slot_type;
+
+		static const size_t	capacity = bp_leaf_capacity<T>::value;
+
+		slot_type	slots[capacity];
+
+		slot_type	*slot(size_t i) { return (&slots[i]); }
+
+		value_type	&value(size_t i) { return (*slots[i].get()); }
+	};
+
+	template <class Key>
+	struct BPInner : public _Bp_node_base
+	{
+		typedef Key				key_type;
+		typedef bp_slot<Key>	slot_type;
+
+		static const size_t	capacity = bp_inner_capacity<Key>::value;
+
+		_Bp_node_base	*children[capacity];
+		slot_type		keys[capacity - 1];
+
+		slot_type	*key_slot(size_t i) { return (&keys[i]); }
+
+		key_type	&key(size_t i) { return (*keys[i].get()); }
+	};
+}
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef EZ_ITERATOR_H
+# define EZ_ITERATOR_H
+
+# include <memory>
+# include <iterator>
+# include <cstddef>
+
+namespace ft
+{
+	/*
+	** An index into an array laid out in Eytzinger order (see _Ez_tree.hpp),
+	** walked in key order: the successor of k is the leftmost node of its
+	** right subtree, or else the parent it is a left child of. 0 is end().
+	** A whole scan costs O(1) amortized per step, but jumps around the array.
+	*/
+	template <class I>
+	class EZIterator
+	{
+	public:
+		typedef I								value_type;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef ptrdiff_t						difference_type;
+		typedef I&								reference;
+		typedef const I&						const_reference;
+		typedef I*								pointer;
+		typedef const I*						const_pointer;
+
+	private:
+		I		*values;
+		size_t	index;
+		size_t	size;
+
+	public:
+		EZIterator() : values(NULL), index(0), size(0) {}
+
+		EZIterator(I *values, size_t index, size_t size) : values(values), index(index), size(size) {}
+
+		EZIterator(EZIterator const &other) : values(other.values), index(other.index), size(other.size) {}
+
+		EZIterator	&operator=(EZIterator const &other)
+		{
+			values = other.values;
+			index = other.index;
+			size = other.size;
+			return (*this);
+		}
+
+		size_t	position() const
+		{
+			return (index);
+		}
+
+		reference	operator*() const
+		{
+			return (values[index]);
+		}
+
+		pointer	operator->() const
+		{
+			return &(values[index]);
+		}
+
+		EZIterator	&operator++()
+		{
+			if (2 * index + 1 <= size)
+			{
+				index = 2 * index + 1;
+				while (2 * index <= size)
+					index = 2 * index;
+			}
+			else
+			{
+				while (index & 1)
+					index >>= 1;
+				index >>= 1;
+			}
+			return (*this);
+		}
+
+		EZIterator	operator++(int)
+		{
+			EZIterator	tmp(*this);
+			operator++();
+			return (tmp);
+		}
+
+		/*
+		** From end(), goes to the last node: the rightmost one.
+		*/
+		EZIterator	&operator--()
+		{
+			if (index == 0)
+			{
+				index = 1;
+				while (2 * index + 1 <= size)
+					index = 2 * index + 1;
+			}
+			else if (2 * index <= size)
+			{
+				index = 2 * index;
+				while (2 * index + 1 <= size)
+					index = 2 * index + 1;
+			}
+			else
+			{
+				while (index && !(index & 1))
+					index >>= 1;
+				index >>= 1;
+			}
+			return (*this);
+		}
+
+		EZIterator	operator--(int)
+		{
+			EZIterator	tmp(*this);
+			operator--();
+			return (tmp);
+		}
+
+		bool	operator==(EZIterator const &other) const
+		{
+			return (index == other.index && values == other.values);
+		}
+
+		bool	operator!=(EZIterator const &other) const
+		{
+			return (!(*this == other));
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef EZ_SIMD_H
+# define EZ_SIMD_H
+
+# include <cstddef>
+# include <functional>
+# if defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+# if defined(__SSE4_2__)
+#  include <nmmintrin.h>
+# endif
+# if defined(__AVX2__)
+#  include <immintrin.h>
+# endif
+
+namespace ft
+{
+	/*
+	** Four levels of an Eytzinger tree in one step. Below node k, the
+	** next levels are the contiguous runs k, 2k.., 4k.. and 8k.., 15 keys
+	** in all, and the 16 nodes four levels down are 16k..16k+15, in key
+	** order. The descent lands on 16k + j, where j counts those 15 keys
+	** that lie before x. Counting them needs no branch and none of the
+	** loads waits for another, unlike four scalar steps.
+	**
+	** before() counts the keys less than x (lower bounds), not_after()
+	** those not greater (upper bounds). They exist only for arithmetic
+	** keys under std::less, and only for what the target instruction set
+	** allows: enabled is false otherwise, and the scalar descent is used.
+	** keys has to be 64-byte aligned.
+	*/
+	template <class Key, class Compare>
+	struct ez_simd
+	{
+		static const bool	enabled = false;
+
+		static unsigned	before(const Key *, size_t, const Key &) { return (0); }
+
+		static unsigned	not_after(const Key *, size_t, const Key &) { return (0); }
+	};
+
+# if defined(__SSE2__)
+
+	/*
+	** A compare leaves -1 in the lanes where it holds; adding the compare
+	** results up lane-wise and then across gives minus the count.
+	*/
+	inline unsigned	ez_count32(__m128i lanes)
+	{
+		lanes = _mm_add_epi32(lanes, _mm_shuffle_epi32(lanes, 0x4e));
+		lanes = _mm_add_epi32(lanes, _mm_shuffle_epi32(lanes, 0xb1));
+		return (-_mm_cvtsi128_si32(lanes));
+	}
+
+	inline unsigned	ez_count64(__m128i lanes)
+	{
+		lanes = _mm_add_epi64(lanes, _mm_unpackhi_epi64(lanes, lanes));
+		return (-_mm_cvtsi128_si32(lanes));
+	}
+
+	/*
+	** The top three keys (k, 2k, 2k + 1) are compared one by one.
+	*/
+	template <class Key>
+	inline unsigned	ez_top_before(const Key *keys, size_t k, const Key &x)
+	{
+		return ((keys[k] < x) + (keys[2 * k] < x) + (keys[2 * k + 1] < x));
+	}
+
+	template <class Key>
+	inline unsigned	ez_top_not_after(const Key *keys, size_t k, const Key &x)
+	{
+		return (!(x < keys[k]) + !(x < keys[2 * k]) + !(x < keys[2 * k + 1]));
+	}
+
+	/*
+	** 32-bit integers; unsigned ones are shifted into the signed range,
+	** as SSE2 only compares signed lanes.
+	*/
+	template <class Key, int Bias>
+	struct ez_simd_int32
+	{
+		static const bool	enabled = true;
+
+		static __m128i	load(const Key *p)
+		{
+			return (_mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i *>(p)), _mm_set1_epi32(Bias)));
+		}
+
+		static unsigned	before(const Key *keys, size_t k, const Key &x)
+		{
+			const __m128i	vx = _mm_set1_epi32(static_cast<int>(x) ^ Bias);
+			__m128i			lanes = _mm_cmpgt_epi32(vx, load(keys + 4 * k));
+
+			lanes = _mm_add_epi32(lanes, _mm_cmpgt_epi32(vx, load(keys + 8 * k)));
+			lanes = _mm_add_epi32(lanes, _mm_cmpgt_epi32(vx, load(keys + 8 * k + 4)));
+			return (ez_top_before(keys, k, x) + ez_count32(lanes));
+		}
+
+		static unsigned	not_after(const Key *keys, size_t k, const Key &x)
+		{
+			const __m128i	vx = _mm_set1_epi32(static_cast<int>(x) ^ Bias);
+			__m128i			lanes = _mm_cmpgt_epi32(load(keys + 4 * k), vx);
+
+			lanes = _mm_add_epi32(lanes, _mm_cmpgt_epi32(load(keys + 8 * k), vx));
+			lanes = _mm_add_epi32(lanes, _mm_cmpgt_epi32(load(keys + 8 * k + 4), vx));
+			return (ez_top_not_after(keys, k, x) + 12 - ez_count32(lanes));
+		}
+	};
+
+	template <>
+	struct ez_simd<int, std::less<int> > : ez_simd_int32<int, 0> {};
+
+	template <>
+	struct ez_simd<unsigned int, std::less<unsigned int> > : ez_simd_int32<unsigned int, static_cast<int>(0x80000000u)> {};
+
+	template <>
+	struct ez_simd<float, std::less<float> >
+	{
+		static const bool	enabled = true;
+
+		static unsigned	before(const float *keys, size_t k, const float &x)
+		{
+			const __m128	vx = _mm_set1_ps(x);
+			__m128i			lanes = _mm_castps_si128(_mm_cmplt_ps(_mm_load_ps(keys + 4 * k), vx));
+
+			lanes = _mm_add_epi32(lanes, _mm_castps_si128(_mm_cmplt_ps(_mm_load_ps(keys + 8 * k), vx)));
+			lanes = _mm_add_epi32(lanes, _mm_castps_si128(_mm_cmplt_ps(_mm_load_ps(keys + 8 * k + 4), vx)));
+			return (ez_top_before(keys, k, x) + ez_count32(lanes));
+		}
+
+		static unsigned	not_after(const float *keys, size_t k, const float &x)
+		{
+			const __m128	vx = _mm_set1_ps(x);
+			__m128i			lanes = _mm_castps_si128(_mm_cmplt_ps(vx, _mm_load_ps(keys + 4 * k)));
+
+			lanes = _mm_add_epi32(lanes, _mm_castps_si128(_mm_cmplt_ps(vx, _mm_load_ps(keys + 8 * k))));
+			lanes = _mm_add_epi32(lanes, _mm_castps_si128(_mm_cmplt_ps(vx, _mm_load_ps(keys + 8 * k + 4))));
+			return (ez_top_not_after(keys, k, x) + 12 - ez_count32(lanes));
+		}
+	};
+
+	/*
+	** Doubles go two to a compare: the runs at 4k and 8k are six compares.
+	*/
+	template <>
+	struct ez_simd<double, std::less<double> >
+	{
+		static const bool	enabled = true;
+
+		static __m128i	less(__m128d lhs, __m128d rhs)
+		{
+			return (_mm_castpd_si128(_mm_cmplt_pd(lhs, rhs)));
+		}
+
+		static unsigned	before(const double *keys, size_t k, const double &x)
+		{
+			const __m128d	vx = _mm_set1_pd(x);
+			__m128i			lanes = less(_mm_load_pd(keys + 4 * k), vx);
+
+			for (size_t i = 2; i < 4; i += 2)
+				lanes = _mm_add_epi64(lanes, less(_mm_load_pd(keys + 4 * k + i), vx));
+			for (size_t i = 0; i < 8; i += 2)
+				lanes = _mm_add_epi64(lanes, less(_mm_load_pd(keys + 8 * k + i), vx));
+			return (ez_top_before(keys, k, x) + ez_count64(lanes));
+		}
+
+		static unsigned	not_after(const double *keys, size_t k, const double &x)
+		{
+			const __m128d	vx = _mm_set1_pd(x);
+			__m128i			lanes = less(vx, _mm_load_pd(keys + 4 * k));
+
+			for (size_t i = 2; i < 4; i += 2)
+				lanes = _mm_add_epi64(lanes, less(vx, _mm_load_pd(keys + 4 * k + i)));
+			for (size_t i = 0; i < 8; i += 2)
+				lanes = _mm_add_epi64(lanes, less(vx, _mm_load_pd(keys + 8 * k + i)));
+			return (ez_top_not_after(keys, k, x) + 12 - ez_count64(lanes));
+		}
+	};
+
+#  if defined(__AVX2__) || defined(__SSE4_2__)
+
+	/*
+	** Signed 64-bit integers, which SSE2 cannot compare: four to a compare
+	** with AVX2, two with SSE4.2. greater() counts the keys after x, or
+	** with keys_first false, before it.
+	*/
+	template <class Key>
+	struct ez_simd_int64
+	{
+		static const bool	enabled = true;
+
+#   if defined(__AVX2__)
+		static unsigned	greater(const Key *keys, size_t k, const Key &x, bool keys_first)
+		{
+			const __m256i	vx = _mm256_set1_epi64x(x);
+			__m256i			lanes = _mm256_setzero_si256();
+			const Key		*runs[3] = { keys + 4 * k, keys + 8 * k, keys + 8 * k + 4 };
+
+			for (int i = 0; i < 3; ++i)
+			{
+				const __m256i	v = _mm256_load_si256(reinterpret_cast<const __m256i *>(runs[i]));
+
+				lanes = _mm256_add_epi64(lanes, keys_first ? _mm256_cmpgt_epi64(v, vx) : _mm256_cmpgt_epi64(vx, v));
+			}
+			return (ez_count64(_mm_add_epi64(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1))));
+		}
+#   else
+		static unsigned	greater(const Key *keys, size_t k, const Key &x, bool keys_first)
+		{
+			const __m128i	vx = _mm_set1_epi64x(x);
+			__m128i			lanes = _mm_setzero_si128();
+			const Key		*runs[6] = { keys + 4 * k, keys + 4 * k + 2, keys + 8 * k, keys + 8 * k + 2, keys + 8 * k + 4, keys + 8 * k + 6 };
+
+			for (int i = 0; i < 6; ++i)
+			{
+				const __m128i	v = _mm_load_si128(reinterpret_cast<const __m128i *>(runs[i]));
+
+				lanes = _mm_add_epi64(lanes, keys_first ? _mm_cmpgt_epi64(v, vx) : _mm_cmpgt_epi64(vx, v));
+			}
+			return (ez_count64(lanes));
+		}
+#   endif
+
+		static unsigned	before(const Key *keys, size_t k, const Key &x)
+		{
+			return (ez_top_before(keys, k, x) + greater(keys, k, x, false));
+		}
+
+		static unsigned	not_after(const Key *keys, size_t k, const Key &x)
+		{
+			return (ez_top_not_after(keys, k, x) + 12 - greater(keys, k, x, true));
+		}
+	};
+
+#   if defined(__LP64__)
+	template <>
+	struct ez_simd<long, std::less<long> > : ez_simd_int64<long> {};
+#   endif
+
+	template <>
+	struct ez_simd<long long, std::less<long long> > : ez_simd_int64<long long> {};
+
+#  endif
+# endif
+}
+
+#endif
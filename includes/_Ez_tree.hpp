@@ -0,0 +1,406 @@
+#ifndef _EZ_TREE_H
+# define _EZ_TREE_H
+
+# include <new>
+# include <memory>
+# include <limits>
+# include <algorithm>
+# include <stdint.h>
+# include "utilities.hpp"
+# include "pair.hpp"
+# include "iterator_traits.hpp"
+# include "_Ez_iterator.hpp"
+# include "_Ez_simd.hpp"
+
+namespace ft
+{
+	/*
+	** Immutable sorted array in Eytzinger order, the engine of frozen_map
+	** and frozen_set. Key, T, KeyOfValue and Compare play the same roles
+	** as in RBTree. Slot 0 is unused; the children of slot k are 2k and
+	** 2k + 1, i.e. the array is a complete binary search tree stored level
+	** by level. The keys get an array of their own, 64-byte aligned, and
+	** the values a parallel one; for a set both are the same array.
+	**
+	** A search runs from the root without a branch on the keys: k becomes
+	** 2k or 2k + 1 until it leaves the array, and the answer is what is
+	** left of k once the trailing right turns are dropped. Every step
+	** prefetches the cache line holding the nodes a few levels below.
+	** Arithmetic keys under std::less descend four levels at a time where
+	** the instruction set allows it (see _Ez_simd.hpp).
+	*/
+	template <class Key, class T, class KeyOfValue, class Compare = std::less<Key>, class Allocator = std::allocator<T> >
+	class EZTree
+	{
+		public:
+			typedef Key															key_type;
+			typedef T															value_type;
+			typedef KeyOfValue													key_of_value;
+			typedef Compare														key_compare;
+			typedef Allocator													allocator_type;
+			typedef size_t														size_type;
+			typedef ptrdiff_t													difference_type;
+			typedef typename allocator_type::reference							reference;
+			typedef typename allocator_type::const_reference					const_reference;
+			typedef typename allocator_type::pointer							pointer;
+			typedef typename allocator_type::const_pointer						const_pointer;
+			typedef EZIterator<const value_type>								const_iterator;
+			typedef ft::reverse_iterator<const_iterator>						const_reverse_iterator;
+			typedef typename Allocator::template rebind<key_type>::other		key_allocator;
+
+		private:
+			typedef ez_simd<key_type, key_compare>								simd;
+
+			static const bool		_shared = ft::is_same<key_type, value_type>::value;
+			static const size_type	_line_keys = (sizeof(key_type) < 64 ? 64 / sizeof(key_type) : 1);
+			static const size_type	_align_slack = (simd::enabled ? _line_keys : 0);
+			static const size_type	_wide_slots = 16384 / sizeof(key_type);
+
+		public:
+			/****************************************************************************\
+			**								Member functions							**
+			\****************************************************************************/
+
+			explicit EZTree(const key_compare &comp, const allocator_type &alloc)
+				: _comp(comp), _alloc(alloc), _alloc_key(alloc), _raw_keys(NULL), _keys(NULL), _values(NULL), _size(0) {}
+
+			EZTree(const EZTree &other)
+				: _comp(other._comp), _alloc(other._alloc), _alloc_key(other._alloc_key), _raw_keys(NULL), _keys(NULL), _values(NULL), _size(0)
+			{
+				copy(other);
+			}
+
+			EZTree	&operator=(const EZTree &other)
+			{
+				if (this != &other)
+				{
+					EZTree	tmp(other);
+
+					swap(tmp);
+				}
+				return (*this);
+			}
+
+			~EZTree()
+			{
+				clear();
+			}
+
+			/*
+			** Lays out the n values from first, which have to come in strictly
+			** increasing key order, as ft::map and ft::set iterate.
+			*/
+			template <class InputIt>
+			void	build(InputIt first, size_type n)
+			{
+				size_type	built = 0;
+
+				clear();
+				allocate(n);
+				try
+				{
+					fill(1, first, built);
+				}
+				catch (...)
+				{
+					destroy_first(built);
+					deallocate();
+					throw;
+				}
+			}
+
+			void	swap(EZTree &other)
+			{
+				ft::swap_elements(_comp, other._comp);
+				ft::swap_elements(_alloc, other._alloc);
+				ft::swap_elements(_alloc_key, other._alloc_key);
+				ft::swap_elements(_raw_keys, other._raw_keys);
+				ft::swap_elements(_keys, other._keys);
+				ft::swap_elements(_values, other._values);
+				ft::swap_elements(_size, other._size);
+			}
+
+			/****************************************************************************\
+			**									Iterators								**
+			\****************************************************************************/
+
+			const_iterator	begin() const
+			{
+				size_type	k = (_size ? 1 : 0);
+
+				while (k && 2 * k <= _size)
+					k = 2 * k;
+				return (at(k));
+			}
+
+			const_iterator	end() const
+			{
+				return (at(0));
+			}
+
+			const_reverse_iterator	rbegin() const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rend() const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			/****************************************************************************\
+			**									Capacity								**
+			\****************************************************************************/
+
+			bool	empty() const
+			{
+				return (!_size);
+			}
+
+			size_type	size() const
+			{
+				return (_size);
+			}
+
+			size_type	max_size() const
+			{
+				return (std::min<size_type>(_alloc_key.max_size(), std::numeric_limits<difference_type>::max()) - _align_slack - 1);
+			}
+
+			/****************************************************************************\
+			**									Lookup									**
+			\****************************************************************************/
+
+			template <class K>
+			const_iterator	find(const K &k) const
+			{
+				size_type	found = descend(k, false);
+
+				if (found && !_comp(k, _keys[found]))
+					return (at(found));
+				return (end());
+			}
+
+			template <class K>
+			const_iterator	lower_bound(const K &k) const
+			{
+				return (at(descend(k, false)));
+			}
+
+			template <class K>
+			const_iterator	upper_bound(const K &k) const
+			{
+				return (at(descend(k, true)));
+			}
+
+			template <class K>
+			ft::pair<const_iterator, const_iterator>	equal_range(const K &k) const
+			{
+				const_iterator	first = lower_bound(k);
+				const_iterator	last = first;
+
+				if (first != end() && !_comp(k, _keys[first.position()]))
+					++last;
+				return (ft::make_pair(first, last));
+			}
+
+			key_compare	key_comp() const
+			{
+				return (_comp);
+			}
+
+			allocator_type	get_allocator() const
+			{
+				return (_alloc);
+			}
+
+		private:
+			const_iterator	at(size_type k) const
+			{
+				return (const_iterator(_values, k, _size));
+			}
+
+			/*
+			** The slot of the first key not before x (upper: after x), 0 if
+			** there is none.
+			*/
+			template <class K>
+			size_type	descend(const K &x, bool upper) const
+			{
+				size_type	k = wide_steps(x, upper);
+
+				while (k <= _size)
+				{
+					ft::prefetch(_keys + std::min(k * _line_keys, _size));
+					k = 2 * k + (upper ? !_comp(x, _keys[k]) : _comp(_keys[k], x));
+				}
+				return (k >> (trailing_ones(k) + 1));
+			}
+
+			/*
+			** Where the scalar descent starts: the root, or for keys ez_simd
+			** handles, as far as whole four-level steps go within the top 16 KB
+			** of the array. Those levels stay in L1; below them each step would
+			** wait on memory, and the scalar descent prefetches while the wide
+			** one cannot.
+			*/
+			template <class K>
+			size_type	wide_steps(const K &, bool) const
+			{
+				return (1);
+			}
+
+			size_type	wide_steps(const key_type &x, bool upper) const
+			{
+				const size_type	last = (_size < _wide_slots ? _size : _wide_slots);
+				size_type		k = 1;
+
+				if (!simd::enabled)
+					return (k);
+				while (16 * k + 15 <= last)
+					k = 16 * k + (upper ? simd::not_after(_keys, k, x) : simd::before(_keys, k, x));
+				return (k);
+			}
+
+			static size_type	trailing_ones(size_type k)
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return (__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+				size_type	n = 0;
+
+				for (; k & 1; k >>= 1)
+					++n;
+				return (n);
+#endif
+			}
+
+			/*
+			** In-order fill: slot k gets the values of its left subtree first.
+			*/
+			template <class InputIt>
+			void	fill(size_type k, InputIt &it, size_type &built)
+			{
+				while (k <= _size)
+				{
+					fill(2 * k, it, built);
+					construct(k, *it);
+					++it;
+					++built;
+					k = 2 * k + 1;
+				}
+			}
+
+			void	construct(size_type k, const value_type &value)
+			{
+				_alloc_key.construct(_keys + k, key_of_value()(value));
+				if (_shared)
+					return ;
+				try
+				{
+					_alloc.construct(_values + k, value);
+				}
+				catch (...)
+				{
+					_alloc_key.destroy(_keys + k);
+					throw;
+				}
+			}
+
+			void	destroy(size_type k)
+			{
+				_alloc_key.destroy(_keys + k);
+				if (!_shared)
+					_alloc.destroy(_values + k);
+			}
+
+			/*
+			** The first n slots in key order, after a failed build().
+			*/
+			void	destroy_first(size_type n)
+			{
+				for (const_iterator it = begin(); n; --n, ++it)
+					destroy(it.position());
+			}
+
+			void	copy(const EZTree &other)
+			{
+				size_type	k = 1;
+
+				allocate(other._size);
+				try
+				{
+					for (; k <= _size; ++k)
+						construct(k, other._values[k]);
+				}
+				catch (...)
+				{
+					while (--k)
+						destroy(k);
+					deallocate();
+					throw;
+				}
+			}
+
+			void	clear()
+			{
+				for (size_type k = 1; k <= _size; ++k)
+					destroy(k);
+				deallocate();
+			}
+
+			/*
+			** Keys that ez_simd reads get one extra cache line, to align slot 0.
+			*/
+			void	allocate(size_type n)
+			{
+				if (!n)
+					return ;
+				_raw_keys = _alloc_key.allocate(n + 1 + _align_slack);
+				_keys = _raw_keys;
+				if (_align_slack)
+					_keys += (64 - reinterpret_cast<uintptr_t>(_raw_keys) % 64) % 64 / sizeof(key_type);
+				if (!_shared)
+				{
+					try
+					{
+						_values = _alloc.allocate(n + 1);
+					}
+					catch (...)
+					{
+						_alloc_key.deallocate(_raw_keys, n + 1 + _align_slack);
+						_raw_keys = NULL;
+						_keys = NULL;
+						throw;
+					}
+				}
+				else
+					_values = reinterpret_cast<value_type *>(_keys);
+				_size = n;
+			}
+
+			void	deallocate()
+			{
+				if (_raw_keys)
+				{
+					_alloc_key.deallocate(_raw_keys, _size + 1 + _align_slack);
+					if (!_shared)
+						_alloc.deallocate(_values, _size + 1);
+				}
+				_raw_keys = NULL;
+				_keys = NULL;
+				_values = NULL;
+				_size = 0;
+			}
+
+			key_compare		_comp;
+			allocator_type	_alloc;
+			key_allocator	_alloc_key;
+			key_type		*_raw_keys;
+			key_type		*_keys;
+			value_type		*_values;
+			size_type		_size;
+	};
+}
+
+#endif
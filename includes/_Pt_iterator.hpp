@@ -0,0 +1,143 @@
+#ifndef PT_ITERATOR_H
+# define PT_ITERATOR_H
+
+# include <memory>
+# include <iterator>
+# include "_Pt_tree_node.hpp"
+
+namespace ft
+{
+	/*
+	** Nodes have no parent link, so the iterator carries the path from the
+	** root down to its element; the empty path is end(). The tree is
+	** height-balanced, with a height below 1.45 log2(n + 2), so 64 levels are
+	** enough for any tree that fits in memory. An iterator stays valid for
+	** as long as the version it was taken from is alive.
+	*/
+	template <class T>
+	class PTIterator
+	{
+	public:
+		typedef T								value_type;
+		typedef std::bidirectional_iterator_tag	iterator_category;
+		typedef PNode<T>						tree_node;
+		typedef ptrdiff_t						difference_type;
+		typedef const T&						reference;
+		typedef const T&						const_reference;
+		typedef const T*						pointer;
+		typedef const T*						const_pointer;
+
+		static const size_t	max_depth = 64;
+
+	private:
+		const tree_node	*root;
+		const tree_node	*path[max_depth];
+		size_t			depth;
+
+	public:
+		PTIterator() : root(NULL), depth(0) {}
+
+		explicit PTIterator(const tree_node *root) : root(root), depth(0) {}
+
+		PTIterator(PTIterator const &other) : root(other.root), depth(other.depth)
+		{
+			for (size_t i = 0; i < depth; ++i)
+				path[i] = other.path[i];
+		}
+
+		PTIterator	&operator=(PTIterator const &other)
+		{
+			root = other.root;
+			depth = other.depth;
+			for (size_t i = 0; i < depth; ++i)
+				path[i] = other.path[i];
+			return (*this);
+		}
+
+		/*
+		** Building blocks for the tree's descents: push() extends the path by
+		** one node, truncate() cuts it back to its first n nodes.
+		*/
+		void	push(const tree_node *node)
+		{
+			path[depth++] = node;
+		}
+
+		void	truncate(size_t n)
+		{
+			depth = n;
+		}
+
+		const tree_node	*base() const
+		{
+			return (depth ? path[depth - 1] : NULL);
+		}
+
+		reference	operator*() const
+		{
+			return (path[depth - 1]->data);
+		}
+
+		pointer	operator->() const
+		{
+			return &(path[depth - 1]->data);
+		}
+
+		PTIterator	&operator++()
+		{
+			const tree_node	*node = path[depth - 1];
+
+			if (node->right)
+			{
+				for (node = node->right; node; node = node->left)
+					push(node);
+				return (*this);
+			}
+			while (--depth && path[depth - 1]->right == node)
+				node = path[depth - 1];
+			return (*this);
+		}
+
+		PTIterator	operator++(int)
+		{
+			PTIterator	tmp(*this);
+			operator++();
+			return (tmp);
+		}
+
+		PTIterator	&operator--()
+		{
+			const tree_node	*node = depth ? path[depth - 1]->left : root;
+
+			if (node)
+			{
+				for (; node; node = node->right)
+					push(node);
+				return (*this);
+			}
+			node = path[depth - 1];
+			while (--depth && path[depth - 1]->left == node)
+				node = path[depth - 1];
+			return (*this);
+		}
+
+		PTIterator	operator--(int)
+		{
+			PTIterator	tmp(*this);
+			operator--();
+			return (tmp);
+		}
+
+		bool	operator==(PTIterator const &other) const
+		{
+			return (base() == other.base());
+		}
+
+		bool	operator!=(PTIterator const &other) const
+		{
+			return (base() != other.base());
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,526 @@
+#ifndef _PT_TREE_H
+# define _PT_TREE_H
+
+# include <new>
+# include <mutex>
+# include <memory>
+# include <limits>
+# include "utilities.hpp"
+# include "pair.hpp"
+# include "_Pt_tree_node.hpp"
+# include "_Pt_iterator.hpp"
+# include "iterator_traits.hpp"
+
+namespace ft
+{
+	/*
+	** Persistent search tree: a PTree is one version, a root and a size, and
+	** copying it is O(1) as the copy shares every node. An update builds new
+	** nodes along the path it walks, O(log n) of them, and leaves the old
+	** version untouched for whoever still holds it.
+	**
+	** The tree is AVL-balanced rather than red-black: without parent links
+	** or in-place recolouring, the rebalancing after an erase is a plain
+	** rebuild of the path on the way back up.
+	**
+	** One thread may update a version while others copy it: the root is
+	** swapped and grabbed under _publish, and everything else a reader
+	** touches is immutable. Updates to one version must not race each other.
+	** Nodes are freed by whichever thread drops their last reference, so the
+	** allocator has to be thread-safe.
+	*/
+	template <class Key, class T, class KeyOfValue, class Compare = std::less<Key>, class Allocator = std::allocator<T> >
+	class PTree
+	{
+		public:
+			typedef Key														key_type;
+			typedef T														value_type;
+			typedef KeyOfValue												key_of_value;
+			typedef Compare													key_compare;
+			typedef Allocator												allocator_type;
+			typedef size_t													size_type;
+			typedef ptrdiff_t												difference_type;
+			typedef typename allocator_type::const_reference				const_reference;
+			typedef typename allocator_type::const_pointer					const_pointer;
+			typedef PTIterator<value_type>									const_iterator;
+			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+			typedef PNode<value_type>										tree_node;
+			typedef typename Allocator::template rebind<tree_node>::other	node_allocator;
+
+		public:
+			/****************************************************************************\
+			**								Member functions							**
+			\****************************************************************************/
+
+			explicit PTree(const key_compare &comp, const allocator_type &alloc)
+				: _comp(comp), _root(NULL), _size(0), _alloc_node(alloc), _alloc(alloc) {}
+
+			PTree(const PTree &other)
+				: _comp(other._comp), _root(NULL), _size(0), _alloc_node(other._alloc_node), _alloc(other._alloc)
+			{
+				_root = other.acquire(_size);
+			}
+
+			PTree	&operator=(const PTree &other)
+			{
+				if (this != &other)
+				{
+					size_type	size;
+					tree_node	*root = other.acquire(size);
+
+					_comp = other._comp;
+					publish(root, size);
+				}
+				return (*this);
+			}
+
+			~PTree()
+			{
+				release(_root);
+			}
+
+			allocator_type	get_allocator() const
+			{
+				return (_alloc);
+			}
+
+			/****************************************************************************\
+			**									Iterators								**
+			\****************************************************************************/
+
+			const_iterator	begin() const
+			{
+				const_iterator	it(_root);
+
+				for (const tree_node *node = _root; node; node = node->left)
+					it.push(node);
+				return (it);
+			}
+
+			const_iterator	end() const
+			{
+				return (const_iterator(_root));
+			}
+
+			const_reverse_iterator	rbegin() const
+			{
+				return (const_reverse_iterator(end()));
+			}
+
+			const_reverse_iterator	rend() const
+			{
+				return (const_reverse_iterator(begin()));
+			}
+
+			/****************************************************************************\
+			**									Capacity								**
+			\****************************************************************************/
+
+			bool	empty() const
+			{
+				return (!_size);
+			}
+
+			size_type	size() const
+			{
+				return (_size);
+			}
+
+			size_type	max_size() const { return std::min<size_type>(_alloc_node.max_size(),
+									std::numeric_limits<difference_type>::max()); }
+
+			/****************************************************************************\
+			**									Modifiers								**
+			\****************************************************************************/
+
+			void	clear()
+			{
+				publish(NULL, 0);
+			}
+
+			/*
+			** With assign, an equal key has its value replaced (the node is
+			** copied like the rest of the path); without, the tree is left
+			** alone. Returns whether the key was new.
+			*/
+			bool	insert(const value_type &data, bool assign)
+			{
+				bool	found = search(key_of_value()(data)) != NULL;
+
+				if (found && !assign)
+					return (false);
+				publish(path_insert(_root, data), _size + !found);
+				return (!found);
+			}
+
+			template <class K>
+			size_type	erase(const K &k)
+			{
+				if (!search(k))
+					return (0);
+				publish(path_erase(_root, k), _size - 1);
+				return (1);
+			}
+
+			void	swap(PTree &x)
+			{
+				ft::swap_elements(_comp, x._comp);
+				ft::swap_elements(_root, x._root);
+				ft::swap_elements(_size, x._size);
+				ft::swap_elements(_alloc_node, x._alloc_node);
+				ft::swap_elements(_alloc, x._alloc);
+			}
+
+			/****************************************************************************\
+			**									Lookup									**
+			\****************************************************************************/
+
+			template <class K>
+			const tree_node	*search(const K &k) const
+			{
+				const tree_node	*node = _root;
+
+				while (node)
+				{
+					if (_comp(k, key(node)))
+						node = node->left;
+					else if (_comp(key(node), k))
+						node = node->right;
+					else
+						return (node);
+				}
+				return (NULL);
+			}
+
+			template <class K>
+			const_iterator	find(const K &k) const
+			{
+				const_iterator	it(_root);
+
+				for (const tree_node *node = _root; node; )
+				{
+					it.push(node);
+					if (_comp(k, key(node)))
+						node = node->left;
+					else if (_comp(key(node), k))
+						node = node->right;
+					else
+						return (it);
+				}
+				return (end());
+			}
+
+			/*
+			** The bound is the last node the descent turned left at, and the
+			** path to it is a prefix of the descent.
+			*/
+			template <class K>
+			const_iterator	lower_bound(const K &k) const
+			{
+				const_iterator	it(_root);
+				size_type		bound = 0;
+				size_type		depth = 0;
+
+				for (const tree_node *node = _root; node; ++depth)
+				{
+					it.push(node);
+					if (!_comp(key(node), k))
+					{
+						bound = depth + 1;
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				it.truncate(bound);
+				return (it);
+			}
+
+			template <class K>
+			const_iterator	upper_bound(const K &k) const
+			{
+				const_iterator	it(_root);
+				size_type		bound = 0;
+				size_type		depth = 0;
+
+				for (const tree_node *node = _root; node; ++depth)
+				{
+					it.push(node);
+					if (_comp(k, key(node)))
+					{
+						bound = depth + 1;
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				it.truncate(bound);
+				return (it);
+			}
+
+			template <class K>
+			ft::pair<const_iterator, const_iterator>	equal_range(const K &k) const
+			{
+				const_iterator	first = lower_bound(k);
+				const_iterator	last = first;
+
+				if (first != end() && !_comp(k, key_of_value()(*first)))
+					++last;
+				return (ft::make_pair(first, last));
+			}
+
+		private:
+			/****************************************************************************\
+			**										Node								**
+			\****************************************************************************/
+
+			static const key_type	&key(const tree_node *node)
+			{
+				return (key_of_value()(node->data));
+			}
+
+			static tree_node	*retain(const tree_node *node)
+			{
+				if (node)
+					node->refs.fetch_add(1, std::memory_order_relaxed);
+				return (const_cast<tree_node *>(node));
+			}
+
+			/*
+			** Drops one reference; the last one frees the node and passes the
+			** release on to its children.
+			*/
+			void	release(const tree_node *node)
+			{
+				while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					tree_node	*dead = const_cast<tree_node *>(node);
+
+					release(dead->left);
+					node = dead->right;
+					dead->~tree_node();
+					_alloc_node.deallocate(dead, 1);
+				}
+			}
+
+			/*
+			** Takes over the references to left and right the caller holds,
+			** and drops them if the node cannot be built.
+			*/
+			tree_node	*new_node(const value_type &data, tree_node *left, tree_node *right)
+			{
+				tree_node	*node = NULL;
+
+				try
+				{
+					node = _alloc_node.allocate(1);
+					::new (static_cast<void *>(node)) tree_node(data, left, right);
+				}
+				catch (...)
+				{
+					if (node)
+						_alloc_node.deallocate(node, 1);
+					release(left);
+					release(right);
+					throw ;
+				}
+				return (node);
+			}
+
+			/*
+			** Holds a reference while a path is being built: it is dropped when
+			** the guard goes out of scope, unless take() handed it on.
+			*/
+			class node_guard
+			{
+				public:
+					node_guard(PTree &tree, tree_node *node) : _tree(tree), _node(node) {}
+
+					~node_guard() { _tree.release(_node); }
+
+					tree_node	*take()
+					{
+						tree_node	*node = _node;
+
+						_node = NULL;
+						return (node);
+					}
+
+				private:
+					node_guard(const node_guard &);
+					node_guard	&operator=(const node_guard &);
+
+					PTree		&_tree;
+					tree_node	*_node;
+			};
+
+			/*
+			** Grabs a reference to the current version for a reader.
+			*/
+			tree_node	*acquire(size_type &size) const
+			{
+				std::lock_guard<std::mutex>	lock(_publish);
+
+				size = _size;
+				return (retain(_root));
+			}
+
+			/*
+			** Makes root the current version, then drops the previous one: its
+			** nodes that the new version does not share are freed unless a
+			** copy still holds them.
+			*/
+			void	publish(tree_node *root, size_type size)
+			{
+				tree_node	*old;
+
+				{
+					std::lock_guard<std::mutex>	lock(_publish);
+
+					old = _root;
+					_root = root;
+					_size = size;
+				}
+				release(old);
+			}
+
+			/****************************************************************************\
+			**									Path copying							**
+			\****************************************************************************/
+
+			static int	balance_factor(const tree_node *left, const tree_node *right)
+			{
+				return (tree_node::height_of(left) - tree_node::height_of(right));
+			}
+
+			/*
+			** Builds the node (data, left, right), restoring the AVL property with
+			** new nodes when the two heights are two apart. The intermediate
+			** node a rotation takes apart is freed straight away. Like
+			** new_node(), takes over left and right even when it throws; the
+			** nodes are built one statement at a time so that each reference
+			** has a single owner at every point.
+			*/
+			tree_node	*balance(const value_type &data, tree_node *left, tree_node *right)
+			{
+				int	factor = balance_factor(left, right);
+
+				if (factor > 1)
+				{
+					node_guard	old(*this, left);
+
+					if (balance_factor(left->left, left->right) < 0)
+					{
+						node_guard	keep(*this, right);
+						tree_node	*pivot = left->right;
+						node_guard	low(*this, new_node(left->data, retain(left->left), retain(pivot->left)));
+						tree_node	*high = new_node(data, retain(pivot->right), keep.take());
+
+						return (new_node(pivot->data, low.take(), high));
+					}
+
+					tree_node	*high = new_node(data, retain(left->right), right);
+
+					return (new_node(left->data, retain(left->left), high));
+				}
+				if (factor < -1)
+				{
+					node_guard	old(*this, right);
+
+					if (balance_factor(right->left, right->right) > 0)
+					{
+						tree_node	*pivot = right->left;
+						node_guard	low(*this, new_node(data, left, retain(pivot->left)));
+						tree_node	*high = new_node(right->data, retain(pivot->right), retain(right->right));
+
+						return (new_node(pivot->data, low.take(), high));
+					}
+
+					tree_node	*low = new_node(data, left, retain(right->left));
+
+					return (new_node(right->data, low, retain(right->right)));
+				}
+				return (new_node(data, left, right));
+			}
+
+			/*
+			** The recursive halves return a new subtree the caller owns; node
+			** itself is only read. The new half is built before the other one
+			** is retained, so a throw leaves nothing behind.
+			*/
+			tree_node	*path_insert(const tree_node *node, const value_type &data)
+			{
+				if (!node)
+					return (new_node(data, NULL, NULL));
+
+				const key_type	&k = key_of_value()(data);
+
+				if (_comp(k, key(node)))
+				{
+					tree_node	*left = path_insert(node->left, data);
+
+					return (balance(node->data, left, retain(node->right)));
+				}
+				if (_comp(key(node), k))
+				{
+					tree_node	*right = path_insert(node->right, data);
+
+					return (balance(node->data, retain(node->left), right));
+				}
+				return (new_node(data, retain(node->left), retain(node->right)));
+			}
+
+			/*
+			** k must be in the subtree.
+			*/
+			template <class K>
+			tree_node	*path_erase(const tree_node *node, const K &k)
+			{
+				if (_comp(k, key(node)))
+				{
+					tree_node	*left = path_erase(node->left, k);
+
+					return (balance(node->data, left, retain(node->right)));
+				}
+				if (_comp(key(node), k))
+				{
+					tree_node	*right = path_erase(node->right, k);
+
+					return (balance(node->data, retain(node->left), right));
+				}
+				if (!node->left)
+					return (retain(node->right));
+				if (!node->right)
+					return (retain(node->left));
+
+				const tree_node	*successor = node->right;
+
+				while (successor->left)
+					successor = successor->left;
+
+				tree_node	*right = path_erase_min(node->right);
+
+				return (balance(successor->data, retain(node->left), right));
+			}
+
+			tree_node	*path_erase_min(const tree_node *node)
+			{
+				if (!node->left)
+					return (retain(node->right));
+
+				tree_node	*left = path_erase_min(node->left);
+
+				return (balance(node->data, left, retain(node->right)));
+			}
+
+		private:
+			key_compare			_comp;
+			tree_node			*_root;
+			size_type			_size;
+			node_allocator		_alloc_node;
+			allocator_type		_alloc;
+			mutable std::mutex	_publish;
+	};
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef _PT_TREE_NODE_H
+# define _PT_TREE_NODE_H
+
+# include <cstddef>
+# include <atomic>
+
+namespace ft {
+
+	/*
+	** Node of the persistent tree behind persistent_map. A node is never
+	** modified once built: an update copies the nodes on its path and shares
+	** every other subtree with the previous version, so a node may have any
+	** number of parents and carries no parent link. refs counts the parents
+	** and map versions holding it; whoever drops it to zero frees the node
+	** and releases its two children. Versions live on different threads, so
+	** the count is atomic.
+	*/
+	template <class T>
+	struct PNode
+	{
+		typedef T	value_type;
+
+		PNode								*left;
+		PNode								*right;
+		mutable std::atomic<unsigned int>	refs;
+		unsigned char						height;
+		value_type							data;
+
+		PNode(const value_type &data, PNode *left, PNode *right)
+			: left(left), right(right), refs(1), height(1 + max_height(left, right)), data(data) {}
+
+		static unsigned char	height_of(const PNode *node)
+		{
+			return (node ? node->height : 0);
+		}
+
+		static unsigned char	max_height(const PNode *a, const PNode *b)
+		{
+			return (height_of(a) > height_of(b) ? height_of(a) : height_of(b));
+		}
+
+	private:
+		PNode(const PNode &);
+		PNode	&operator=(const PNode &);
+	};
+}
+
+#endif
@@ -7,22 +7,22 @@
 
 namespace ft
 {
-	template <class I>
+	template <class I, class Augment = rb_no_augment>
 	class RBIterator
 	{
 	public:
 		typedef I								value_type;
 		typedef std::bidirectional_iterator_tag	iterator_category;
-		typedef Node<value_type>				tree_node;
-		typedef Node<const value_type>			const_tree_node;
+		typedef Node<value_type, Augment>		tree_node;
+		typedef Node<const value_type, Augment>	const_tree_node;
 		typedef ptrdiff_t						difference_type;
 		typedef I&								reference;
 		typedef const I&						const_reference;
 		typedef I*								pointer;
 		typedef const I*						const_pointer;
 			
-		typedef RBIterator<I>					iterator;
-		typedef RBIterator<const I>				const_iterator;
+		typedef RBIterator<I, Augment>			iterator;
+		typedef RBIterator<const I, Augment>	const_iterator;
 
 	private:
 		tree_node	*node;
@@ -68,19 +68,19 @@ namespace ft
 
 		RBIterator	&operator++()
 		{
-			if (!node->leaf)
+			if (node->sentinel)
 				return (*this);
-			if (node && node->right && node->right->leaf)
+			if (!node->right->sentinel)
 			{
 				node = node->right;
-				while (node && node->left && node->left->leaf)
+				while (!node->left->sentinel)
 					node = node->left;
 			}
 			else
 			{
 				tree_node	*tmp = node;
 				node = node->parent;
-				while (node && node->leaf && node->right == tmp)
+				while (!node->sentinel && node->right == tmp)
 				{
 					tmp = node;
 					node = node->parent;
@@ -98,25 +98,22 @@ namespace ft
 
 		RBIterator	&operator--()
 		{
-			if (!node->leaf)
+			if (node->sentinel)
 			{
-				while (node->parent->leaf)
-					node = node->parent;
-				while (node->right->leaf)
-					node = node->right;
+				node = node->right;
 				return (*this);
 			}
-			else if (node->left && node->left->leaf)
+			else if (!node->left->sentinel)
 			{
 				node = node->left;
-				while (node->right && node->right->leaf)
+				while (!node->right->sentinel)
 					node = node->right;
 			}
 			else
 			{
 				tree_node	*tmp = node;
 				node = node->parent;
-				while (node && node->leaf && node->left == tmp)
+				while (!node->sentinel && node->left == tmp)
 				{
 					tmp = node;
 					node = node->parent;
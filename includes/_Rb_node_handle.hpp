@@ -0,0 +1,199 @@
+#ifndef _RB_NODE_HANDLE_H
+# define _RB_NODE_HANDLE_H
+
+# include <memory>
+# include <cstddef>
+# include "utilities.hpp"
+
+namespace ft
+{
+	/*
+	** Owns a node taken out of a tree by extract(), value included, until it
+	** is inserted in a tree of the same type or the handle goes away. It
+	** also holds the stores the node's memory belongs to (see
+	** _Rb_node_pool.hpp), so it may outlive the tree it came from.
+	**
+	** Handles are never duplicated. As with std::auto_ptr, copying or
+	** assigning one hands the node over and leaves the source empty. A
+	** handle_ref stands in for a temporary, so that a handle can be returned
+	** by value before C++11.
+	**
+	** The value can be changed freely while it is out of any tree, key
+	** included for a set; a dropped handle destroys the value, and the slot
+	** goes back to the allocator with the rest of its chunk.
+	*/
+	template <class Node, class Pool, class Allocator>
+	class RBNodeHandle
+	{
+		template <class, class, class, class, class, class>
+		friend class RBTree;
+
+		public:
+			typedef typename Node::value_type	value_type;
+			typedef Allocator					allocator_type;
+
+		private:
+			typedef typename Pool::store_set	store_set;
+
+			struct handle_ref
+			{
+				RBNodeHandle	*handle;
+
+				explicit handle_ref(RBNodeHandle *handle) : handle(handle) {}
+			};
+
+		public:
+			RBNodeHandle() : _node(NULL), _stores(NULL), _alloc() {}
+
+			RBNodeHandle(RBNodeHandle &other) : _node(NULL), _stores(NULL), _alloc(other._alloc)
+			{
+				swap(other);
+			}
+
+			RBNodeHandle(handle_ref ref) : _node(NULL), _stores(NULL), _alloc(ref.handle->_alloc)
+			{
+				swap(*ref.handle);
+			}
+
+			RBNodeHandle	&operator=(RBNodeHandle &other)
+			{
+				if (this != &other)
+				{
+					reset();
+					swap(other);
+				}
+				return (*this);
+			}
+
+			RBNodeHandle	&operator=(handle_ref ref)
+			{
+				return (*this = *ref.handle);
+			}
+
+			operator	handle_ref()
+			{
+				return (handle_ref(this));
+			}
+
+			~RBNodeHandle()
+			{
+				reset();
+			}
+
+			bool	empty() const
+			{
+				return (!_node);
+			}
+
+			/*
+			** Non-null when the handle holds a node, for `if (handle)`.
+			*/
+			operator	void *() const
+			{
+				return (_node);
+			}
+
+			allocator_type	get_allocator() const
+			{
+				return (_alloc);
+			}
+
+			value_type	&value() const
+			{
+				return (_node->data);
+			}
+
+			void	swap(RBNodeHandle &other)
+			{
+				ft::swap_elements(_node, other._node);
+				ft::swap_elements(_stores, other._stores);
+				ft::swap_elements(_alloc, other._alloc);
+			}
+
+		private:
+			RBNodeHandle(Node *node, store_set *stores, const allocator_type &alloc)
+				: _node(node), _stores(stores), _alloc(alloc) {}
+
+			/*
+			** Gives the node up to a tree, which has adopted the stores first.
+			*/
+			Node	*release()
+			{
+				Node	*node = _node;
+
+				Pool::drop(_stores);
+				_node = NULL;
+				_stores = NULL;
+				return (node);
+			}
+
+			void	reset()
+			{
+				typedef typename Node::augment_data	augment_data;
+
+				if (!_node)
+					return ;
+				_alloc.destroy(&(_node->data));
+				static_cast<augment_data *>(_node)->~augment_data();
+				release();
+			}
+
+			Node			*_node;
+			store_set		*_stores;
+			allocator_type	_alloc;
+	};
+
+	template <class Node, class Pool, class Allocator>
+	void	swap(RBNodeHandle<Node, Pool, Allocator> &lhs, RBNodeHandle<Node, Pool, Allocator> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+
+	/*
+	** What inserting a node handle returns: on failure, node still holds the
+	** node and position is the element with the same key. It carries a
+	** handle, so it copies the way a handle does.
+	*/
+	template <class Iterator, class NodeHandle>
+	struct RBInsertReturn
+	{
+		private:
+			struct return_ref
+			{
+				RBInsertReturn	*ret;
+
+				explicit return_ref(RBInsertReturn *ret) : ret(ret) {}
+			};
+
+		public:
+			Iterator	position;
+			bool		inserted;
+			NodeHandle	node;
+
+			RBInsertReturn(Iterator position, bool inserted) : position(position), inserted(inserted), node() {}
+
+			RBInsertReturn(RBInsertReturn &other) : position(other.position), inserted(other.inserted), node(other.node) {}
+
+			RBInsertReturn(return_ref ref) : position(ref.ret->position), inserted(ref.ret->inserted), node(ref.ret->node) {}
+
+			RBInsertReturn	&operator=(RBInsertReturn &other)
+			{
+				position = other.position;
+				inserted = other.inserted;
+				node = other.node;
+				return (*this);
+			}
+
+			RBInsertReturn	&operator=(return_ref ref)
+			{
+				return (*this = *ref.ret);
+			}
+
+			operator	return_ref()
+			{
+				return (return_ref(this));
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,401 @@
+#ifndef _RB_NODE_POOL_H
+# define _RB_NODE_POOL_H
+
+# include <memory>
+# include <vector>
+# include <cstddef>
+# if __cplusplus >= 201103L
+#  include <atomic>
+# endif
+# include "utilities.hpp"
+
+namespace ft
+{
+	/*
+	** Slab storage for tree nodes: nodes are carved out of chunks obtained in
+	** one allocator call each, and erased nodes are threaded on an intrusive
+	** free list instead of being handed back. A node never moves once carved,
+	** so iterators stay valid; memory goes back to the allocator a whole chunk
+	** at a time, on release() or destruction.
+	**
+	** Nodes may move to another tree (extract, merge) without being copied.
+	** To keep them alive, the chunks of a pool live in a reference-counted
+	** store, and a pool holds a set of stores: its own, plus those of every
+	** pool it took nodes from. A store is freed when the last set holding it
+	** is; until then, nodes that moved away keep the chunks of the tree they
+	** came from alive. Nodes freed in a pool go on its own free list,
+	** whichever store they belong to. From C++11 on, store and set counts
+	** are atomic, so pools on different threads may trade nodes; before
+	** that they are plain counters.
+	**
+	** A pool whose nodes never left it can also be recycled as a whole once
+	** they are all destroyed: its chunks are then carved again from the
+	** start, as if just allocated.
+	*/
+	template <class Node, class NodeAllocator>
+	class RBNodePool
+	{
+		public:
+			typedef Node			node_type;
+			typedef NodeAllocator	allocator_type;
+			typedef size_t			size_type;
+
+		private:
+			struct chunk_header
+			{
+				chunk_header	*next;
+				size_type		slots;
+			};
+
+			struct free_slot
+			{
+				free_slot	*next;
+			};
+
+# if __cplusplus >= 201103L
+			typedef std::atomic<size_type>	ref_count;
+
+			static void	add_ref(ref_count &refs)
+			{
+				refs.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			/*
+			** True when that was the last reference.
+			*/
+			static bool	drop_ref(ref_count &refs)
+			{
+				return (refs.fetch_sub(1, std::memory_order_acq_rel) == 1);
+			}
+# else
+			typedef size_type	ref_count;
+
+			static void	add_ref(ref_count &refs)
+			{
+				++refs;
+			}
+
+			static bool	drop_ref(ref_count &refs)
+			{
+				return (--refs == 0);
+			}
+# endif
+
+			struct chunk_store
+			{
+				ref_count				refs;
+				chunk_header			*chunks;
+				allocator_type			alloc;
+
+				explicit chunk_store(const allocator_type &alloc) : refs(0), chunks(NULL), alloc(alloc) {}
+			};
+
+		public:
+			/*
+			** Immutable once built, so that it can be shared: adopting new
+			** stores builds a new set.
+			*/
+			struct store_set
+			{
+				ref_count					refs;
+				std::vector<chunk_store *>	stores;
+
+				store_set() : refs(1), stores() {}
+			};
+
+		private:
+			static const size_type	_chunk_bytes = 4096;
+			static const size_type	_header_slots = (sizeof(chunk_header) + sizeof(node_type) - 1) / sizeof(node_type);
+
+		public:
+			explicit RBNodePool(const allocator_type &alloc = allocator_type())
+				: _alloc(alloc), _own(NULL), _set(NULL), _free(NULL), _cursor(NULL), _end(NULL), _next(NULL), _last(NULL),
+				_available(0), _capacity(0), _lent(false) {}
+
+			~RBNodePool()
+			{
+				release();
+			}
+
+			/*
+			** Raw storage for one node; the caller constructs what it needs.
+			*/
+			node_type	*allocate()
+			{
+				node_type	*slot;
+
+				if (_free)
+				{
+					slot = reinterpret_cast<node_type *>(_free);
+					_free = _free->next;
+				}
+				else
+				{
+					if (_cursor == _end)
+					{
+						if (!_next)
+							grow(chunk_nodes());
+						open(_next);
+					}
+					slot = _cursor++;
+				}
+				--_available;
+				return (slot);
+			}
+
+			void	deallocate(node_type *node)
+			{
+				free_slot	*slot = reinterpret_cast<free_slot *>(node);
+
+				slot->next = _free;
+				_free = slot;
+				++_available;
+			}
+
+			/*
+			** Makes sure the next n allocate() calls do not reach the allocator.
+			*/
+			void	reserve(size_type n)
+			{
+				if (n > _available)
+					grow(n - _available);
+			}
+
+			/*
+			** Drops this pool's hold on its stores: its chunks are freed, unless
+			** nodes carved from them now live in another pool or a handle.
+			*/
+			void	release()
+			{
+				drop(_set);
+				_own = NULL;
+				_set = NULL;
+				_free = NULL;
+				_cursor = NULL;
+				_end = NULL;
+				_next = NULL;
+				_last = NULL;
+				_available = 0;
+				_capacity = 0;
+				_lent = false;
+			}
+
+			/*
+			** Takes every slot back at once, for a tree whose nodes have all
+			** been destroyed, and keeps the chunks for the next ones. Does
+			** nothing and returns false when some node may not be this pool's
+			** to take back: one that came from another store, or that went to
+			** a handle or another pool. release() it then.
+			*/
+			bool	recycle()
+			{
+				if (!_own || _lent || _set->stores.size() != 1)
+					return (false);
+				_free = NULL;
+				_cursor = NULL;
+				_end = NULL;
+				_next = _own->chunks;
+				_available = _capacity;
+				return (true);
+			}
+
+			/*
+			** A reference to the stores any node of this pool belongs to, for a
+			** node leaving it; give it back with drop().
+			*/
+			store_set	*share()
+			{
+				_lent = true;
+				if (_set)
+					add_ref(_set->refs);
+				return (_set);
+			}
+
+			static void	drop(store_set *set)
+			{
+				if (!set || !drop_ref(set->refs))
+					return ;
+				for (size_type i = 0; i < set->stores.size(); ++i)
+					drop_store(set->stores[i]);
+				delete set;
+			}
+
+			/*
+			** Keeps the stores of set alive for as long as this pool, as nodes
+			** carved from them are coming in. Free when they are held already.
+			*/
+			void	adopt(const store_set *set)
+			{
+				if (!set || set == _set || covers(set))
+					return ;
+
+				store_set	*merged = new store_set;
+
+				if (_set)
+					merged->stores = _set->stores;
+				for (size_type i = 0; i < set->stores.size(); ++i)
+					if (!_set || !holds(_set, set->stores[i]))
+						merged->stores.push_back(set->stores[i]);
+				for (size_type i = 0; i < merged->stores.size(); ++i)
+					add_ref(merged->stores[i]->refs);
+				drop(_set);
+				_set = merged;
+			}
+
+			void	adopt(RBNodePool &other)
+			{
+				other._lent = true;
+				adopt(other._set);
+			}
+
+			/*
+			** Takes over every store and free slot of other, which is left
+			** empty: the nodes other handed out now belong to this pool.
+			*/
+			void	splice(RBNodePool &other)
+			{
+				while (other._cursor != other._end || other._next)
+				{
+					if (other._cursor == other._end)
+						other.open(other._next);
+					other.deallocate(other._cursor++);
+					--other._available;
+				}
+				adopt(other._set);
+				if (other._free)
+				{
+					free_slot	*last_slot = other._free;
+
+					while (last_slot->next)
+						last_slot = last_slot->next;
+					last_slot->next = _free;
+					_free = other._free;
+				}
+				_available += other._available;
+				other._free = NULL;
+				other.release();
+			}
+
+			size_type	available() const
+			{
+				return (_available);
+			}
+
+			void	swap(RBNodePool &other)
+			{
+				ft::swap_elements(_alloc, other._alloc);
+				ft::swap_elements(_own, other._own);
+				ft::swap_elements(_set, other._set);
+				ft::swap_elements(_free, other._free);
+				ft::swap_elements(_cursor, other._cursor);
+				ft::swap_elements(_end, other._end);
+				ft::swap_elements(_next, other._next);
+				ft::swap_elements(_last, other._last);
+				ft::swap_elements(_available, other._available);
+				ft::swap_elements(_capacity, other._capacity);
+				ft::swap_elements(_lent, other._lent);
+			}
+
+		private:
+			RBNodePool(const RBNodePool &);
+			RBNodePool	&operator=(const RBNodePool &);
+
+			static size_type	chunk_nodes()
+			{
+				size_type	n = _chunk_bytes / sizeof(node_type);
+
+				return (n > _header_slots ? n - _header_slots : 1);
+			}
+
+			static bool	holds(const store_set *set, const chunk_store *store)
+			{
+				for (size_type i = 0; i < set->stores.size(); ++i)
+					if (set->stores[i] == store)
+						return (true);
+				return (false);
+			}
+
+			bool	covers(const store_set *set) const
+			{
+				if (!_set)
+					return (false);
+				for (size_type i = 0; i < set->stores.size(); ++i)
+					if (!holds(_set, set->stores[i]))
+						return (false);
+				return (true);
+			}
+
+			static void	drop_store(chunk_store *store)
+			{
+				if (!drop_ref(store->refs))
+					return ;
+				while (store->chunks)
+				{
+					chunk_header	*next = store->chunks->next;
+
+					store->alloc.deallocate(reinterpret_cast<node_type *>(store->chunks), store->chunks->slots);
+					store->chunks = next;
+				}
+				delete store;
+			}
+
+			/*
+			** Starts carving a chunk. The chunks of the own store are listed
+			** oldest first and carved in that order, which recycle() starts
+			** over from the first.
+			*/
+			void	open(chunk_header *chunk)
+			{
+				_cursor = reinterpret_cast<node_type *>(chunk) + _header_slots;
+				_end = reinterpret_cast<node_type *>(chunk) + chunk->slots;
+				_next = chunk->next;
+			}
+
+			/*
+			** Queues a chunk of at least n nodes, to be carved once the ones
+			** before it are. The pool's own store is made on the first chunk.
+			*/
+			void	grow(size_type n)
+			{
+				if (n < chunk_nodes())
+					n = chunk_nodes();
+				if (!_own)
+				{
+					store_set	own;
+
+					own.stores.push_back(new chunk_store(_alloc));
+					adopt(&own);
+					_own = own.stores.front();
+				}
+
+				node_type		*raw = _alloc.allocate(n + _header_slots);
+				chunk_header	*header = reinterpret_cast<chunk_header *>(raw);
+
+				header->next = NULL;
+				header->slots = n + _header_slots;
+				if (_last)
+					_last->next = header;
+				else
+					_own->chunks = header;
+				_last = header;
+				if (!_next)
+					_next = header;
+				_available += n;
+				_capacity += n;
+			}
+
+			allocator_type	_alloc;
+			chunk_store		*_own;
+			store_set		*_set;
+			free_slot		*_free;
+			node_type		*_cursor;
+			node_type		*_end;
+			chunk_header	*_next;
+			chunk_header	*_last;
+			size_type		_available;
+			size_type		_capacity;
+			bool			_lent;
+	};
+}
+
+#endif
@@ -1,20 +1,37 @@
 #ifndef _RB_TREE_H
 # define _RB_TREE_H
 
+# include <new>
+# include <exception>
+# if __cplusplus >= 201103L
+#  include <thread>
+#  include <system_error>
+# endif
 # include "utilities.hpp"
 # include "pair.hpp"
 # include "_Rb_tree_node.hpp"
 # include "_Rb_iterator.hpp"
+# include "_Rb_node_pool.hpp"
+# include "_Rb_node_handle.hpp"
 # include "iterator_traits.hpp"
 
 namespace ft
 {
-	template <class T, class Compare = std::less<T>, class Allocator = std::allocator<T> >
+	/*
+	** Key is what the tree orders by and T what a node stores; KeyOfValue
+	** extracts the former from the latter, so lookups never have to build a
+	** whole value just to compare keys. Augment is the per-node augmentation
+	** policy (see _Rb_tree_node.hpp).
+	*/
+	template <class Key, class T, class KeyOfValue, class Compare = std::less<Key>, class Allocator = std::allocator<T>,
+		class Augment = rb_no_augment>
 	class RBTree
 	{
 		public:
+			typedef Key														key_type;
 			typedef T														value_type;
-			typedef Compare													value_compare;
+			typedef KeyOfValue												key_of_value;
+			typedef Compare													key_compare;
 			typedef Allocator												allocator_type;
 			typedef size_t													size_type;
 			typedef ptrdiff_t												difference_type;
@@ -22,45 +39,79 @@ namespace ft
 			typedef typename allocator_type::const_reference				const_reference;
 			typedef typename allocator_type::pointer						pointer;
 			typedef typename allocator_type::const_pointer					const_pointer;
-			typedef RBIterator<value_type>									iterator;
-			typedef RBIterator<const value_type>							const_iterator;
+			typedef Augment													augment_type;
+			typedef RBIterator<value_type, augment_type>					iterator;
+			typedef RBIterator<const value_type, augment_type>				const_iterator;
 			typedef ft::reverse_iterator<iterator>							reverse_iterator;
 			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
-			typedef Node<value_type>										tree_node;
+			typedef Node<value_type, augment_type>							tree_node;
 			typedef typename Allocator::template rebind<tree_node>::other	node_allocator;
+			typedef RBNodePool<tree_node, node_allocator>					node_pool;
+			typedef RBNodeHandle<tree_node, node_pool, allocator_type>		node_handle;
 		
 		public:
 			/****************************************************************************\
 			**								Member functions							**
 			\****************************************************************************/
 
-			explicit RBTree(const value_compare &comp, const allocator_type &alloc) : _comp(comp), _node_ptr(new_nil_leaf()), _alloc_pair(alloc), _size(0)
+			explicit RBTree(const key_compare &comp, const allocator_type &alloc) : _comp(comp), _node_ptr(new_nil_leaf()), _pool(alloc), _alloc_pair(alloc), _size(0),
+				_finger(NULL), _finger_on(false)
 			{
 				_root = _node_ptr;
-				_node_ptr->color = "black";
+				_node_ptr->color = _S_black;
 			}
 
-			RBTree(const RBTree &other) : _comp(other._comp), _node_ptr(new_nil_leaf()), _root(_node_ptr), _alloc_pair(other._alloc_pair), _size(0)
+			RBTree(const RBTree &other) : _comp(other._comp), _node_ptr(new_nil_leaf()), _root(_node_ptr), _pool(other._alloc_pair), _alloc_pair(other._alloc_pair), _size(0),
+				_finger(NULL), _finger_on(false)
 			{
-				*this = other;
+				try
+				{
+					*this = other;
+				}
+				catch (...)
+				{
+					delete_null_node(_node_ptr);
+					throw;
+				}
 			}
 
+			/*
+			** The nodes already held go back to the pool first, so the copy is
+			** built in them and only allocates what other has beyond them. If a
+			** value fails to copy, the tree is left empty.
+			*/
 			RBTree &operator=(const RBTree &other)
 			{
 				if (this != &other)
 				{
-					clear(_root);
-					insert(other.begin(), other.end());
+					clear();
 					_comp = other._comp;
 					_alloc_pair = other._alloc_pair;
-					_size = other._size;
+					_finger_on = other._finger_on;
+					if (other._root != other._node_ptr)
+					{
+						_pool.reserve(other._size);
+						try
+						{
+							clone_subtree(other._root, _node_ptr, other._node_ptr, _root);
+						}
+						catch (...)
+						{
+							clear();
+							throw;
+						}
+						leftmost() = get_leftmost_node(_root);
+						rightmost() = get_rightmost_node(_root);
+					}
 				}
 				return (*this);
 			}
 
 			~RBTree()
 			{
-				clear(_root);
+				if (!_node_ptr)
+					return ;	// retired worker, see retire_worker()
+				destroy_subtree(_root);
 				delete_null_node(_node_ptr);
 			}
 
@@ -75,36 +126,22 @@ namespace ft
 
 			iterator	begin()
 			{
-				tree_node	*node;
-
-				if (_root == _node_ptr)
-					return (iterator(_node_ptr));
-				node = _root;
-				while (node && node->left != _node_ptr)
-					node = node->left;
-				return (iterator(node));			
+				return (iterator(leftmost()));
 			}
 
 			const_iterator	begin() const
 			{
-				tree_node	*node;
-
-				if (_root == _node_ptr)
-					return (iterator(_node_ptr));
-				node = _root;
-				while (node && node->left != _node_ptr)
-					node = node->left;
-				return (iterator(node));			
+				return (iterator(leftmost()));
 			}
 
 			iterator	end()
 			{
-				return (iterator(get_rightmost_node(_root)));
+				return (iterator(_node_ptr));
 			}
 
 			const_iterator	end() const
 			{
-				return (iterator(get_rightmost_node(_root)));
+				return (iterator(_node_ptr));
 			}
 
 			reverse_iterator	rbegin()
@@ -144,91 +181,405 @@ namespace ft
 			size_type	max_size() const { return std::min<size_type>(_alloc_node.max_size(),
 									std::numeric_limits<difference_type>::max()); }
 
+			void	reserve(size_type n)
+			{
+				if (n > _size)
+					_pool.reserve(n - _size);
+			}
+
 			/****************************************************************************\
 			**									Modifiers								**
 			\****************************************************************************/
 
-			void	clear(tree_node *node)
+			/*
+			** The pool keeps its chunks when it can recycle them (see
+			** RBNodePool::recycle()): refilling the tree to its former size
+			** then allocates nothing. The memory is handed back when the tree
+			** is destroyed, or swapped with an empty one.
+			*/
+			void	clear()
 			{
-				if (node && node->leaf)
-				{
-					clear(node->left);
-					clear(node->right);
-					delete_node(node);
-				}
+				destroy_subtree(_root);
+				_finger = NULL;
+				if (!_pool.recycle())
+					_pool.release();
 				_root = _node_ptr;
+				leftmost() = _node_ptr;
+				rightmost() = _node_ptr;
+				_size = 0;
+			}
+
+			/*
+			** Replaces the contents with [first, last), in the nodes of the
+			** former ones; the range must not point into this tree.
+			*/
+			template <class InputIt>
+			void	assign(InputIt first, InputIt last,
+				typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+			{
+				clear();
+				insert(first, last);
 			}
 			
 			ft::pair<iterator, bool>	insert(const value_type &data)
+			{
+				tree_node	*parent;
+				bool		left;
+				tree_node	*found = find_insert_pos(key_of_value()(data), parent, left);
+
+				if (found)
+					return (ft::make_pair(iterator(found), false));
+				return (ft::make_pair(insert_at(parent, left, data), true));
+			}
+
+			/*
+			** Descends once to where k belongs. Returns the node holding an
+			** equivalent key, or NULL with parent and left telling where a new
+			** node has to be hooked; insert_at() and emplace_at() finish the job
+			** without a second descent.
+			*/
+			tree_node	*find_insert_pos(const key_type &k, tree_node *&parent, bool &left) const
 			{
 				tree_node	*node = _root;
-				tree_node	*parent = _node_ptr;
 
-				if (_root == _node_ptr)
-				{
-					_root = new_node(data, _node_ptr, 2);
-					_root->color = "black";
-					return (ft::make_pair(iterator(_root), true));
-				}
+				parent = _node_ptr;
+				left = true;
 				while (node != _node_ptr)
 				{
 					parent = node;
-					if (_comp(data, node->data))
+					if (_comp(k, key(node)))
+					{
+						left = true;
 						node = node->left;
-					else if (_comp(node->data, data))
+					}
+					else if (_comp(key(node), k))
+					{
+						left = false;
 						node = node->right;
+					}
 					else
-						return (ft::make_pair(iterator(node), false));
+						return (node);
 				}
-				node = new_node(data, parent, 1);
-				if (_comp(data, parent->data))
-					parent->left = node;
-				else
-					parent->right = node;
-				node->left->parent = node;
-				node->right->parent = node;
-				_Rb_tree_rebalancing(node);
-				return (ft::make_pair(iterator(node), true));
+				return (NULL);
+			}
+
+			iterator	insert_at(tree_node *parent, bool left, const value_type &data)
+			{
+				tree_node	*node = new_node(data, parent);
+
+				link_node(node, parent, left);
+				return (iterator(node));
+			}
+
+			iterator	insert_hint(tree_node *hint, const value_type &data)
+			{
+				tree_node	*parent;
+				bool		left;
+				tree_node	*found = find_insert_hint_pos(hint, key_of_value()(data), parent, left);
+
+				if (found)
+					return (iterator(found));
+				return (insert_at(parent, left, data));
+			}
+
+			/*
+			** Builds the value straight in the new node from (first, second).
+			*/
+			template <class A1, class A2>
+			iterator	emplace_at(tree_node *parent, bool left, const A1 &first, const A2 &second)
+			{
+				tree_node	*node = new_node(first, second, parent);
+
+				link_node(node, parent, left);
+				return (iterator(node));
 			}
 
 			iterator	insert(iterator pos, const value_type &data)
 			{
-				(void)pos;
-				return (insert(data).first);
+				return (insert_hint(pos.base(), data));
 			}
 
 			iterator	insert(const_iterator pos, const value_type &data)
 			{
-				(void)pos;
-				return (insert(data).first);
+				return (insert_hint(node_of(pos), data));
+			}
+
+			/*
+			** Same as find_insert_pos(), but first tries to place k right before
+			** hint, or right after it: a good hint costs one or two comparisons
+			** and a neighbour step, so feeding sorted input with end() as the
+			** hint inserts in amortized constant time. A wrong hint falls back to
+			** the full descent.
+			*/
+			tree_node	*find_insert_hint_pos(tree_node *hint, const key_type &k, tree_node *&parent, bool &left) const
+			{
+				if (hint == _node_ptr)
+				{
+					if (_size && _comp(key(rightmost()), k))
+					{
+						parent = rightmost();
+						left = false;
+						return (NULL);
+					}
+					return (find_insert_pos(k, parent, left));
+				}
+				if (_comp(k, key(hint)))
+				{
+					if (hint == leftmost())
+					{
+						parent = hint;
+						left = true;
+						return (NULL);
+					}
+					tree_node	*before = (--iterator(hint)).base();
+					if (!_comp(key(before), k))
+						return (find_insert_pos(k, parent, left));
+					left = (before->right != _node_ptr);
+					parent = left ? hint : before;
+					return (NULL);
+				}
+				if (_comp(key(hint), k))
+				{
+					if (hint == rightmost())
+					{
+						parent = hint;
+						left = false;
+						return (NULL);
+					}
+					tree_node	*after = (++iterator(hint)).base();
+					if (!_comp(k, key(after)))
+						return (find_insert_pos(k, parent, left));
+					left = (hint->right != _node_ptr);
+					parent = left ? after : hint;
+					return (NULL);
+				}
+				return (hint);
 			}
 
+			/*
+			** Every element is hinted at end(): sorted input then never descends
+			** and the whole range goes in in linear time, while unsorted input
+			** only pays one extra comparison per element.
+			*/
 			template <class InputIt>
 			void	insert(InputIt first, InputIt last,
 				typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
 			{
 				while (first != last)
-					insert(*first++);
+					insert_hint(_node_ptr, *first++);
 			}
 
-			void	erase(iterator first, iterator last)
+			/*
+			** The iterator erasures unlink the node they are given and return
+			** its successor; nothing is searched for, so erasing k consecutive
+			** elements costs O(k) amortized on top of finding the first one.
+			*/
+			iterator	erase(iterator pos)
 			{
-				while (first != last)
-					erase(*first++);
+				tree_node	*node = pos.base();
+
+				++pos;
+				erase(node);
+				return (pos);
 			}
 
-			void	erase(const_iterator first, const_iterator last)
+			iterator	erase(const_iterator pos)
 			{
-				while (first != last)
-					erase(*first++);
+				return (erase(iterator(node_of(pos))));
+			}
+
+			/*
+			** Short ranges are unlinked node by node. Past a few nodes the rest
+			** of the range is cut out with two splits and the outer parts joined
+			** back, so the tree is restructured in O(log n) whatever the length
+			** and the k erased nodes are only visited to be destroyed.
+			*/
+			iterator	erase(iterator first, iterator last)
+			{
+				if (first == begin() && last == end())
+				{
+					clear();
+					return (end());
+				}
+				for (size_type n = 0; first != last && n < _short_range; ++n)
+				{
+					tree_node	*node = first.base();
+
+					++first;
+					erase(node);
+				}
+				if (first == last)
+					return (last);
+
+				rb_subtree	left;
+				rb_subtree	middle;
+				rb_subtree	right;
+				tree_node	*low = split(whole(), key(first.base()), left, middle);
+
+				if (last == end())
+				{
+					delete_subtree(middle.root);
+					set_whole(left);
+				}
+				else
+				{
+					tree_node	*high = split(middle, key(last.base()), middle, right);
+
+					delete_subtree(middle.root);
+					set_whole(join(left, high, right));
+				}
+				delete_node(low);
+				return (last);
+			}
+
+			iterator	erase(const_iterator first, const_iterator last)
+			{
+				return (erase(iterator(node_of(first)), iterator(node_of(last))));
 			}
 
 			void	erase(tree_node *node)
+			{
+				unlink_node(node);
+				delete_node(node);
+			}
+
+			template <class K>
+			size_type	erase(const K &k)
+			{
+				tree_node *found = search(_root, k);
+				if (found)
+				{
+					erase(found);
+					return (1);
+				}
+				return (0);
+			}
+
+			/****************************************************************************\
+			**									Node handles							**
+			\****************************************************************************/
+
+			/*
+			** extract() unlinks a node and hands it over, value untouched, in a
+			** node_handle; insert() links the node of a handle back, into any
+			** tree of this type, unless its key is taken, in which case the
+			** handle keeps it. merge() moves over every node of other whose key
+			** is not in this tree. None of them copies or allocates an element.
+			*/
+			node_handle	extract(iterator pos)
+			{
+				tree_node	*node = pos.base();
+
+				unlink_node(node);
+				--_size;
+				return (node_handle(node, _pool.share(), _alloc_pair));
+			}
+
+			node_handle	extract(const_iterator pos)
+			{
+				return (extract(iterator(node_of(pos))));
+			}
+
+			template <class K>
+			node_handle	extract(const K &k)
+			{
+				tree_node	*found = search(_root, k);
+
+				if (!found)
+					return (node_handle());
+				return (extract(iterator(found)));
+			}
+
+			ft::pair<iterator, bool>	insert(node_handle &handle)
+			{
+				tree_node	*parent;
+				bool		left;
+
+				if (handle.empty())
+					return (ft::make_pair(end(), false));
+
+				tree_node	*found = find_insert_pos(key(handle._node), parent, left);
+
+				if (found)
+					return (ft::make_pair(iterator(found), false));
+				_pool.adopt(handle._stores);
+				return (ft::make_pair(relink_at(parent, left, handle.release()), true));
+			}
+
+			iterator	insert(iterator hint, node_handle &handle)
+			{
+				tree_node	*parent;
+				bool		left;
+
+				if (handle.empty())
+					return (end());
+
+				tree_node	*found = find_insert_hint_pos(hint.base(), key(handle._node), parent, left);
+
+				if (found)
+					return (iterator(found));
+				_pool.adopt(handle._stores);
+				return (relink_at(parent, left, handle.release()));
+			}
+
+			iterator	insert(const_iterator hint, node_handle &handle)
+			{
+				return (insert(iterator(node_of(hint)), handle));
+			}
+
+			void	merge(RBTree &other)
+			{
+				iterator	it = other.begin();
+
+				if (&other == this || it == other.end())
+					return ;
+				_pool.adopt(other._pool);
+				while (it != other.end())
+				{
+					tree_node	*node = it.base();
+					tree_node	*parent;
+					bool		left;
+
+					++it;
+					if (find_insert_pos(key(node), parent, left))
+						continue ;
+					other.unlink_node(node);
+					--other._size;
+					relink_at(parent, left, node);
+				}
+			}
+
+		private:
+			/*
+			** Hooks a node that belonged to another tree, or to this one, where
+			** find_insert_pos() said.
+			*/
+			iterator	relink_at(tree_node *parent, bool left, tree_node *node)
+			{
+				node->color = _S_red;
+				node->parent = parent;
+				node->left = _node_ptr;
+				node->right = _node_ptr;
+				link_node(node, parent, left);
+				++_size;
+				return (iterator(node));
+			}
+
+			/*
+			** Takes node out of the tree without freeing it.
+			*/
+			void	unlink_node(tree_node *node)
 			{
 				tree_node	*search = node;
 				tree_node	*tmp;
-				std::string	color = node->color;
-
+				unsigned char	color = node->color;
+
+				if (node == _finger)
+					_finger = NULL;
+				if (node == leftmost())
+					leftmost() = (node->right != _node_ptr) ? get_leftmost_node(node->right) : node->parent;
+				if (node == rightmost())
+					rightmost() = (node->left != _node_ptr) ? get_rightmost_node(node->left) : node->parent;
 				if (node->left == _node_ptr)
 				{
 					tmp = node->right;
@@ -257,206 +608,840 @@ namespace ft
 					search->left->parent = search;
 					search->color = node->color;
 				}
-				if (color == "black")
+				augment_path(tmp->parent);
+				if (color == _S_black)
 					_Rb_tree_recolouring(tmp);
-				delete_node(node);
-			}
-
-			size_type	erase(const value_type &data)
-			{
-				tree_node *found = search(_root, data);
-				if (found)
-				{
-					erase(found);
-					return (1);
-				}
-				return (0);
 			}
 
+		public:
 			void	swap(RBTree &x)
 			{
 				ft::swap_elements(_comp, x._comp);
 				ft::swap_elements(_node_ptr, x._node_ptr);
 				ft::swap_elements(_root, x._root);
 				ft::swap_elements(_alloc_node, x._alloc_node);
+				_pool.swap(x._pool);
 				ft::swap_elements(_alloc_pair, x._alloc_pair);
 				ft::swap_elements(_size, x._size);
+				ft::swap_elements(_finger, x._finger);
+				ft::swap_elements(_finger_on, x._finger_on);
 			}
 
 			/****************************************************************************\
 			**									Lookup									**
 			\****************************************************************************/
 
-			iterator	find(const value_type &data)
+			template <class K>
+			iterator	find(const K &k)
 			{
-				tree_node	*result = search(_root, data);
+				tree_node	*result = search(k);
 				if (result)
 					return (iterator(result));
-				return (iterator(get_rightmost_node(_root)));
+				return (iterator(_node_ptr));
 			}
 
-			iterator	find(const value_type &data) const
+			template <class K>
+			const_iterator	find(const K &k) const
 			{
-				tree_node	*result = search(_root, data);
+				tree_node	*result = search(k);
 				if (result)
 					return (iterator(result));
-				return (iterator(get_rightmost_node(_root)));
+				return (iterator(_node_ptr));
 			}
 
-			tree_node	*lower_bound(const value_type &data)
+			/*
+			** Starts from hint instead of the root (see search_from()): the
+			** closer hint is to k, the cheaper. Any hint is correct.
+			*/
+			template <class K>
+			iterator	find(const_iterator hint, const K &k)
 			{
-				tree_node	*node = _root;
-				tree_node	*tmp = _node_ptr;
+				tree_node	*last;
+				tree_node	*result = search_from(node_of(hint), k, last);
 
-				while (node != _node_ptr)
-				{
-					if (!_comp(node->data, data))
-					{
-						tmp = node;
-						node = node->left;
-					}
-					else
-						node = node->right;
-				}
-				return (tmp);
+				if (result)
+					return (iterator(result));
+				return (iterator(_node_ptr));
 			}
 
-			tree_node	*lower_bound(const value_type &data) const
+			template <class K>
+			const_iterator	find(const_iterator hint, const K &k) const
 			{
-				tree_node	*node = _root;
-				tree_node	*tmp = _node_ptr;
+				tree_node	*last;
+				tree_node	*result = search_from(node_of(hint), k, last);
 
-				while (node != tmp)
-				{
-					if (!_comp(node->data, data))
-					{
-						tmp = node;
-						node = node->left;
-					}
-					else
-						node = node->right;
-				}
-				return (tmp);
+				if (result)
+					return (iterator(result));
+				return (iterator(_node_ptr));
 			}
 
-			tree_node	*upper_bound(const value_type &data)
+			template <class K>
+			iterator	lower_bound(const K &k)
 			{
-				tree_node	*node = _root;
-				tree_node	*tmp = _node_ptr;
-
-				while (node != tmp)
-				{
-					if (!_comp(data, node->data))
-					{
-						tmp = node;
-						node = node->left;
-					}
-					else
-						node = node->right;
-				}
-				return (tmp);
+				return (iterator(lower_bound_node(_root, _node_ptr, k)));
 			}
 
-			tree_node	*upper_bound(const value_type &data) const
+			template <class K>
+			const_iterator	lower_bound(const K &k) const
 			{
-				tree_node	*node = _root;
-				tree_node	*tmp = _node_ptr;
-
-				while (node != tmp)
-				{
-					if (!_comp(data, node->data))
-					{
-						tmp = node;
-						node = node->left;
-					}
-					else
-						node = node->right;
-				}
-				return (tmp);
+				return (iterator(lower_bound_node(_root, _node_ptr, k)));
 			}
 
-		private:
-			/****************************************************************************\
-			**										Node								**
-			\****************************************************************************/
-
-			tree_node	*new_nil_leaf()
+			template <class K>
+			iterator	upper_bound(const K &k)
 			{
-				tree_node	*tmp = _alloc_node.allocate(1);
-				tmp->color = "black";
-				tmp->leaf = 0;
-				tmp->parent = NULL;
-				tmp->left = _node_ptr;
-				tmp->right = _node_ptr;
-				return (tmp);
+				return (iterator(upper_bound_node(_root, _node_ptr, k)));
 			}
 
-			tree_node	*new_node(const value_type &data, tree_node *parent, int leaf)
+			template <class K>
+			const_iterator	upper_bound(const K &k) const
 			{
-				tree_node	*tmp = _alloc_node.allocate(1);
-				_alloc_pair.construct(&(tmp->data), data);
-				tmp->color = "red";
-				tmp->leaf = leaf;
-				tmp->parent = parent;
-				tmp->left = _node_ptr;
-				tmp->right = _node_ptr;
-				++_size;
-				return (tmp);
+				return (iterator(upper_bound_node(_root, _node_ptr, k)));
 			}
 
-			void	delete_node(tree_node *node)
+			template <class K>
+			ft::pair<iterator, iterator>	equal_range(const K &k)
 			{
-				_alloc_pair.destroy(&(node->data));
-				_alloc_node.deallocate(node, 1);
-				--_size;
-			}
+				ft::pair<tree_node *, tree_node *>	range = equal_range_nodes(k);
 
-			void	delete_null_node(tree_node *node)
-			{
-				_alloc_node.deallocate(node, 1);
-				--_size;
+				return (ft::make_pair(iterator(range.first), iterator(range.second)));
 			}
 
-		public:
-			tree_node	*search(tree_node *search, const value_type &data) const
+			template <class K>
+			ft::pair<const_iterator, const_iterator>	equal_range(const K &k) const
 			{
-				while (search != _node_ptr)
-				{
-					if (_comp(data, search->data))
-						search = search->left;
-					else if (_comp(search->data, data))
-						search = search->right;
-					else
-						return (search);
-				}
-				return (NULL);
+				ft::pair<tree_node *, tree_node *>	range = equal_range_nodes(k);
+
+				return (ft::make_pair(const_iterator(iterator(range.first)), const_iterator(iterator(range.second))));
 			}
 
-		private:
 			/****************************************************************************\
-			**																			**
-			**						Red-Black trees utility functions					**
-			**																			**
+			**								Order statistics							**
 			\****************************************************************************/
 
-			tree_node	*get_leftmost_node(tree_node *node) const
+			/*
+			** These need the rb_subtree_size augmentation and run in O(log n).
+			** nth(n) is the n-th element in order (end() past the last one),
+			** rank(k) the number of keys below k, and count_range(lo, hi) the
+			** number of keys in [lo, hi).
+			*/
+			iterator	nth(size_type n)
 			{
-				while (node->left != _node_ptr)
-					node = node->left;
-				return (node);
+				return (iterator(nth_node(n)));
 			}
 
-			tree_node	*get_rightmost_node(tree_node *node) const
+			const_iterator	nth(size_type n) const
 			{
-				while (node && node->leaf)
-					node = node->right;
-				return (node);
+				return (iterator(nth_node(n)));
 			}
 
-			void	_Rb_tree_left_rotation(tree_node *node)
+			template <class K>
+			size_type	rank(const K &k) const
 			{
-				tree_node	*tmp = node->right;
-				node->right = tmp->left;
+				tree_node	*node = _root;
+				size_type	below = 0;
+
+				while (node != _node_ptr)
+				{
+					if (_comp(key(node), k))
+					{
+						below += node->left->subtree_size + 1;
+						node = node->right;
+					}
+					else
+						node = node->left;
+				}
+				return (below);
+			}
+
+			template <class K>
+			size_type	count_range(const K &lo, const K &hi) const
+			{
+				if (!_comp(lo, hi))
+					return (0);
+				return (rank(hi) - rank(lo));
+			}
+
+			/****************************************************************************\
+			**									Aggregates								**
+			\****************************************************************************/
+
+			/*
+			** These need an rb_aggregate augmentation. aggregate(lo, hi) folds the
+			** elements with keys in [lo, hi) in order: below the node where the
+			** bounds part ways, the walk towards each bound picks up whole
+			** subtrees on its inner side, so the cost is O(log n).
+			*/
+			template <class K>
+			typename rb_aggregate_result<augment_type>::type	aggregate(const K &lo, const K &hi) const
+			{
+				typedef typename augment_type::monoid_type	monoid;
+
+				tree_node	*node = _root;
+
+				if (!_comp(lo, hi))
+					return (monoid::identity());
+				while (node != _node_ptr)
+				{
+					if (_comp(key(node), lo))
+						node = node->right;
+					else if (!_comp(key(node), hi))
+						node = node->left;
+					else
+						break;
+				}
+				if (node == _node_ptr)
+					return (monoid::identity());
+				return (monoid::combine(monoid::combine(aggregate_from(node->left, lo), monoid::lift(node->data)),
+					aggregate_below(node->right, hi)));
+			}
+
+			/*
+			** Brings the aggregates back in line after the value at pos was
+			** changed in place.
+			*/
+			void	refresh(iterator pos)
+			{
+				augment_path(pos.base());
+			}
+
+			/****************************************************************************\
+			**									Traversal								**
+			\****************************************************************************/
+
+			/*
+			** Hand every element, in order, to visit, and return it. The walk
+			** keeps the pending ancestors on a stack instead of climbing parent
+			** links, and fetches a node's right child while the visitor works on
+			** the node. for_each_in_range() covers the keys in [lo, hi). The
+			** visitor must not insert or erase.
+			*/
+			template <class Visitor>
+			Visitor	for_each(Visitor visit)
+			{
+				tree_node	*stack[_max_depth];
+
+				walk(stack, 0, _root, static_cast<const key_type *>(NULL), visit);
+				return (visit);
+			}
+
+			template <class Visitor>
+			Visitor	for_each(Visitor visit) const
+			{
+				tree_node				*stack[_max_depth];
+				const_visitor<Visitor>	wrapper(visit);
+
+				walk(stack, 0, _root, static_cast<const key_type *>(NULL), wrapper);
+				return (visit);
+			}
+
+			template <class K, class Visitor>
+			Visitor	for_each_in_range(const K &lo, const K &hi, Visitor visit)
+			{
+				tree_node	*stack[_max_depth];
+
+				if (_comp(lo, hi))
+					walk(stack, lower_bound_path(stack, lo), _node_ptr, &hi, visit);
+				return (visit);
+			}
+
+			template <class K, class Visitor>
+			Visitor	for_each_in_range(const K &lo, const K &hi, Visitor visit) const
+			{
+				tree_node				*stack[_max_depth];
+				const_visitor<Visitor>	wrapper(visit);
+
+				if (_comp(lo, hi))
+					walk(stack, lower_bound_path(stack, lo), _node_ptr, &hi, wrapper);
+				return (visit);
+			}
+
+			/****************************************************************************\
+			**								Set operations								**
+			\****************************************************************************/
+
+			/*
+			** In-place union, intersection and difference with another tree,
+			** built on split and join: other is walked top-down, this tree is
+			** split at each of its keys and the halves are joined back. That is
+			** O(m log(n / m + 1)) comparisons for m the smaller size. The union
+			** copies the missing elements of other; on equal keys the element
+			** already in this tree is kept.
+			**
+			** With threads > 1 the two halves below each of the top keys of
+			** other are handled on separate threads, up to threads of them in
+			** all. other must not be modified meanwhile, and the value type's
+			** copy constructor and destructor must be safe to run concurrently.
+			** Threads need C++11: before that, threads is ignored.
+			**
+			** If an element of other fails to copy, the tree is left valid with
+			** its own elements and part of the result, and the exception is
+			** passed on.
+			*/
+			void	unite(const RBTree &other, unsigned threads = 1)
+			{
+				if (&other == this)
+					return ;
+				set_op_whole(_set_union, other, threads);
+			}
+
+			void	intersect(const RBTree &other, unsigned threads = 1)
+			{
+				if (&other == this)
+					return ;
+				set_op_whole(_set_intersection, other, threads);
+			}
+
+			void	subtract(const RBTree &other, unsigned threads = 1)
+			{
+				if (&other == this)
+				{
+					clear();
+					return ;
+				}
+				set_op_whole(_set_difference, other, threads);
+			}
+
+		private:
+			tree_node	*nth_node(size_type n) const
+			{
+				tree_node	*node = _root;
+
+				while (node != _node_ptr)
+				{
+					size_type	left = node->left->subtree_size;
+
+					if (n < left)
+						node = node->left;
+					else if (n == left)
+						return (node);
+					else
+					{
+						n -= left + 1;
+						node = node->right;
+					}
+				}
+				return (_node_ptr);
+			}
+
+			/*
+			** A red-black tree is at most 2 log2(n + 1) high.
+			*/
+			static const size_t	_max_depth = 2 * 8 * sizeof(size_type);
+
+			template <class Visitor>
+			struct const_visitor
+			{
+				Visitor	&visit;
+
+				const_visitor(Visitor &visit) : visit(visit) {}
+
+				void	operator()(const value_type &value) { visit(value); }
+			};
+
+			/*
+			** Pushes the nodes not below lo on the way down to lo: they are the
+			** ancestors an in-order walk from lo has yet to come back to.
+			*/
+			template <class K>
+			size_t	lower_bound_path(tree_node **stack, const K &lo) const
+			{
+				tree_node	*node = _root;
+				size_t		depth = 0;
+
+				while (node != _node_ptr)
+				{
+					if (_comp(key(node), lo))
+						node = node->right;
+					else
+					{
+						stack[depth++] = node;
+						node = node->left;
+					}
+				}
+				return (depth);
+			}
+
+			/*
+			** In-order walk of node's subtree, then of the depth nodes on the
+			** stack and their right subtrees, up to the first key not below hi
+			** (none with a NULL hi).
+			*/
+			template <class K, class Visitor>
+			void	walk(tree_node **stack, size_t depth, tree_node *node, const K *hi, Visitor &visit) const
+			{
+				for (;;)
+				{
+					while (node != _node_ptr)
+					{
+						ft::prefetch(node->right);
+						stack[depth++] = node;
+						node = node->left;
+					}
+					if (!depth)
+						return ;
+					node = stack[--depth];
+					if (hi && !_comp(key(node), *hi))
+						return ;
+					visit(node->data);
+					node = node->right;
+				}
+			}
+
+			/*
+			** The aggregate of the keys not below lo, then of the keys below hi,
+			** in the subtree of node.
+			*/
+			template <class K>
+			typename rb_aggregate_result<augment_type>::type	aggregate_from(tree_node *node, const K &lo) const
+			{
+				typedef typename augment_type::monoid_type	monoid;
+
+				typename augment_type::aggregate_type	acc = monoid::identity();
+
+				while (node != _node_ptr)
+				{
+					if (_comp(key(node), lo))
+						node = node->right;
+					else
+					{
+						acc = monoid::combine(monoid::combine(monoid::lift(node->data), node->right->aggregate), acc);
+						node = node->left;
+					}
+				}
+				return (acc);
+			}
+
+			template <class K>
+			typename rb_aggregate_result<augment_type>::type	aggregate_below(tree_node *node, const K &hi) const
+			{
+				typedef typename augment_type::monoid_type	monoid;
+
+				typename augment_type::aggregate_type	acc = monoid::identity();
+
+				while (node != _node_ptr)
+				{
+					if (_comp(key(node), hi))
+					{
+						acc = monoid::combine(acc, monoid::combine(node->left->aggregate, monoid::lift(node->data)));
+						node = node->right;
+					}
+					else
+						node = node->left;
+				}
+				return (acc);
+			}
+
+			/****************************************************************************\
+			**										Node								**
+			\****************************************************************************/
+
+			/*
+			** The augmentation data lives and dies with its node, like the
+			** value; for the built-in policies this is a no-op.
+			*/
+			static void	construct_augment(tree_node *node)
+			{
+				::new (static_cast<void *>(static_cast<typename tree_node::augment_data *>(node))) typename tree_node::augment_data();
+			}
+
+			static void	destroy_augment(tree_node *node)
+			{
+				typedef typename tree_node::augment_data	augment_data;
+
+				static_cast<augment_data *>(node)->~augment_data();
+			}
+
+			tree_node	*new_nil_leaf()
+			{
+				tree_node	*tmp = _alloc_node.allocate(1);
+				tmp->color = _S_black;
+				tmp->sentinel = 1;
+				tmp->parent = NULL;
+				tmp->left = tmp;
+				tmp->right = tmp;
+				construct_augment(tmp);
+				augment_type::reset(tmp);
+				return (tmp);
+			}
+
+			tree_node	*new_node(const value_type &data, tree_node *parent)
+			{
+				tree_node	*tmp = _pool.allocate();
+
+				try
+				{
+					_alloc_pair.construct(&(tmp->data), data);
+				}
+				catch (...)
+				{
+					_pool.deallocate(tmp);
+					throw;
+				}
+				construct_augment(tmp);
+				tmp->color = _S_red;
+				tmp->sentinel = 0;
+				tmp->parent = parent;
+				tmp->left = _node_ptr;
+				tmp->right = _node_ptr;
+				++_size;
+				return (tmp);
+			}
+
+			template <class A1, class A2>
+			tree_node	*new_node(const A1 &first, const A2 &second, tree_node *parent)
+			{
+				tree_node	*tmp = _pool.allocate();
+
+				try
+				{
+					::new (static_cast<void *>(&(tmp->data))) value_type(first, second);
+				}
+				catch (...)
+				{
+					_pool.deallocate(tmp);
+					throw;
+				}
+				construct_augment(tmp);
+				tmp->color = _S_red;
+				tmp->sentinel = 0;
+				tmp->parent = parent;
+				tmp->left = _node_ptr;
+				tmp->right = _node_ptr;
+				++_size;
+				return (tmp);
+			}
+
+			void	delete_node(tree_node *node)
+			{
+				if (node == _finger)
+					_finger = NULL;
+				_alloc_pair.destroy(&(node->data));
+				destroy_augment(node);
+				_pool.deallocate(node);
+				--_size;
+			}
+
+			/*
+			** Copies the shape and the colours of a subtree of another tree
+			** (whose nil node is other_nil) into slot, which has to hold nil, so
+			** no comparison is needed and no rebalancing happens. Recurses on
+			** the right, loops on the left. Each node is linked in as soon as it
+			** is built: if a copy throws, what was built hangs from slot, for
+			** the caller to tear down.
+			*/
+			void	clone_subtree(const tree_node *src, tree_node *parent, const tree_node *other_nil, tree_node *&slot)
+			{
+				tree_node	**link = &slot;
+
+				for (; src != other_nil; src = src->left)
+				{
+					tree_node	*node = new_node(src->data, parent);
+
+					node->color = src->color;
+					static_cast<typename tree_node::augment_data &>(*node) = *src;
+					*link = node;
+					if (src->right != other_nil)
+						clone_subtree(src->right, node, other_nil, node->right);
+					parent = node;
+					link = &node->left;
+				}
+			}
+
+			/*
+			** Only runs the value destructors: the storage goes back chunk by
+			** chunk when the pool is released.
+			*/
+			void	destroy_subtree(tree_node *node)
+			{
+				while (!node->sentinel)
+				{
+					destroy_subtree(node->right);
+					tree_node	*left = node->left;
+					_alloc_pair.destroy(&(node->data));
+					destroy_augment(node);
+					node = left;
+				}
+			}
+
+			/*
+			** Destroys and gives back to the pool every node of a detached subtree.
+			*/
+			void	delete_subtree(tree_node *node)
+			{
+				while (node != _node_ptr)
+				{
+					delete_subtree(node->right);
+					tree_node	*left = node->left;
+					delete_node(node);
+					node = left;
+				}
+			}
+
+			void	delete_null_node(tree_node *node)
+			{
+				destroy_augment(node);
+				_alloc_node.deallocate(node, 1);
+				--_size;
+			}
+
+			/*
+			** The lookups are templates over the key type so that transparent
+			** comparators can be fed foreign keys; the containers decide which
+			** key types they let through.
+			**
+			** Bound descents over the subtree rooted at node; bound is what to
+			** return when every key of the subtree compares below k.
+			*/
+			template <class K>
+			tree_node	*lower_bound_node(tree_node *node, tree_node *bound, const K &k) const
+			{
+				while (node != _node_ptr)
+				{
+					if (!_comp(key(node), k))
+					{
+						bound = node;
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				return (bound);
+			}
+
+			template <class K>
+			tree_node	*upper_bound_node(tree_node *node, tree_node *bound, const K &k) const
+			{
+				while (node != _node_ptr)
+				{
+					if (_comp(k, key(node)))
+					{
+						bound = node;
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				return (bound);
+			}
+
+			/*
+			** Descends once until it meets an equivalent key, then finishes the
+			** lower bound in its left subtree and the upper bound in its right one.
+			*/
+			template <class K>
+			ft::pair<tree_node *, tree_node *>	equal_range_nodes(const K &k) const
+			{
+				tree_node	*node = _root;
+				tree_node	*bound = _node_ptr;
+
+				while (node != _node_ptr)
+				{
+					if (_comp(key(node), k))
+						node = node->right;
+					else if (_comp(k, key(node)))
+					{
+						bound = node;
+						node = node->left;
+					}
+					else
+						return (ft::make_pair(lower_bound_node(node->left, node, k),
+							upper_bound_node(node->right, bound, k)));
+				}
+				return (ft::make_pair(bound, bound));
+			}
+
+		public:
+			/*
+			** In finger mode, the tree remembers the node the last lookup
+			** ended on and the next one starts from there: a lookup at
+			** distance d of the previous one costs O(log d), which pays when
+			** successive keys are close. It is off by default, as lookups then
+			** write to the tree: const ones included, so a tree in finger mode
+			** must not be read from several threads at once.
+			*/
+			void	finger_search(bool on)
+			{
+				_finger_on = on;
+				_finger = NULL;
+			}
+
+			bool	finger_search() const
+			{
+				return (_finger_on);
+			}
+
+			/*
+			** The node holding k, or NULL; from the root, or the finger.
+			*/
+			template <class K>
+			tree_node	*search(const K &k) const
+			{
+				if (!_finger_on)
+					return (search(_root, k));
+				return (search_from(_finger ? _finger : _root, k, _finger));
+			}
+
+			template <class K>
+			tree_node	*search(tree_node *search, const K &k) const
+			{
+				while (search != _node_ptr)
+				{
+					if (_comp(k, key(search)))
+						search = search->left;
+					else if (_comp(key(search), k))
+						search = search->right;
+					else
+						return (search);
+				}
+				return (NULL);
+			}
+
+		private:
+			/*
+			** Finger search: climbs from node until its subtree is bound to
+			** hold k, then descends. Climbing off a child on k's side, the
+			** parent's key bounds that subtree on that side, so one comparison
+			** per such step tells when to stop; the other steps compare
+			** nothing. last is set to the last node compared, where a search
+			** for a nearby key should start. node may be nil (end()).
+			*/
+			template <class K>
+			tree_node	*search_from(tree_node *node, const K &k, tree_node *&last) const
+			{
+				last = NULL;
+				if (node == _node_ptr)
+					node = _root;
+				if (node == _node_ptr)
+					return (NULL);
+
+				bool	right = _comp(key(node), k);
+
+				if (!right && !_comp(k, key(node)))
+				{
+					last = node;
+					return (node);
+				}
+				while (node != _root)
+				{
+					tree_node	*parent = node->parent;
+
+					if ((node == parent->left) == right
+						&& (right ? _comp(k, key(parent)) : _comp(key(parent), k)))
+						break ;
+					node = parent;
+				}
+				while (node != _node_ptr)
+				{
+					last = node;
+					if (_comp(k, key(node)))
+						node = node->left;
+					else if (_comp(key(node), k))
+						node = node->right;
+					else
+						return (node);
+				}
+				return (NULL);
+			}
+
+			/****************************************************************************\
+			**																			**
+			**						Red-Black trees utility functions					**
+			**																			**
+			\****************************************************************************/
+
+			/*
+			** A const_iterator walks the very same nodes, seen as holding const
+			** values; this undoes the cast RBIterator does when it converts.
+			*/
+			static tree_node	*node_of(const_iterator it)
+			{
+				return (reinterpret_cast<tree_node *>(it.base()));
+			}
+
+			static const key_type	&key(const tree_node *node)
+			{
+				return (key_of_value()(node->data));
+			}
+
+			/*
+			** Hooks a fresh node under parent (the nil node for an empty tree)
+			** and restores the red-black properties.
+			*/
+			void	link_node(tree_node *node, tree_node *parent, bool left)
+			{
+				if (parent == _node_ptr)
+				{
+					_root = node;
+					leftmost() = node;
+					rightmost() = node;
+				}
+				else if (left)
+				{
+					parent->left = node;
+					if (parent == leftmost())
+						leftmost() = node;
+				}
+				else
+				{
+					parent->right = node;
+					if (parent == rightmost())
+						rightmost() = node;
+				}
+				augment_path(node);
+				_Rb_tree_rebalancing(node);
+			}
+
+			tree_node	*get_leftmost_node(tree_node *node) const
+			{
+				while (node->left != _node_ptr)
+					node = node->left;
+				return (node);
+			}
+
+			tree_node	*get_rightmost_node(tree_node *node) const
+			{
+				while (node->right != _node_ptr)
+					node = node->right;
+				return (node);
+			}
+
+			/*
+			** The nil node doubles as the header: its left and right links cache
+			** the smallest and the largest node (itself when the tree is empty).
+			** Rotations keep the in-order sequence, so only insert and erase
+			** have to maintain them.
+			*/
+			tree_node	*&leftmost() const
+			{
+				return (_node_ptr->left);
+			}
+
+			tree_node	*&rightmost() const
+			{
+				return (_node_ptr->right);
+			}
+
+			/*
+			** Refreshes the augmentation data from node up to the root, after a
+			** structural change below node. Rotations refresh the two nodes they
+			** move themselves.
+			*/
+			void	augment_path(tree_node *node)
+			{
+				if (!augment_type::enabled)
+					return ;
+				while (node != _node_ptr)
+				{
+					augment_type::update(node);
+					node = node->parent;
+				}
+			}
+
+			void	_Rb_tree_left_rotation(tree_node *node)
+			{
+				tree_node	*tmp = node->right;
+				node->right = tmp->left;
 				if (tmp->left != _node_ptr)
 					tmp->left->parent = node;
 				tmp->parent = node->parent;
@@ -468,6 +1453,11 @@ namespace ft
 					node->parent->right = tmp;
 				tmp->left = node;
 				node->parent = tmp;
+				if (augment_type::enabled)
+				{
+					augment_type::update(node);
+					augment_type::update(tmp);
+				}
 			}
 
 			void	_Rb_tree_right_rotation(tree_node *node)
@@ -485,14 +1475,19 @@ namespace ft
 					node->parent->left = tmp;
 				tmp->right = node;
 				node->parent = tmp;
+				if (augment_type::enabled)
+				{
+					augment_type::update(node);
+					augment_type::update(tmp);
+				}
 			}
 
 			void	_Rb_tree_swap_node_colour(tree_node *node)
 			{
-				if (node->color == "red")
-					node->color = "black";
+				if (node->is_red())
+					node->color = _S_black;
 				else
-					node->color = "red";
+					node->color = _S_red;
 			}
 
 			void	_Rb_tree_node_insertion(tree_node *new_node, tree_node *node)
@@ -506,19 +1501,23 @@ namespace ft
 				node->parent = new_node->parent;
 			}
 
-			void	_Rb_tree_rebalancing(tree_node *node)
+			/*
+			** Returns true when the fix-up had to turn a red root black, i.e. when
+			** the black height of the tree grew by one.
+			*/
+			bool	_Rb_tree_rebalancing(tree_node *node)
 			{
-				while (node != _root && node->parent->color == "red")
+				while (node != _root && node->parent->is_red())
 				{
 					tree_node	*node_grandpa = node->parent->parent;
 					if (node->parent == node_grandpa->right)
 					{
 						tree_node	*uncleNode = node_grandpa->left;
-						if (uncleNode->color == "red")
+						if (uncleNode->is_red())
 						{
-							uncleNode->color = "black";
-							node->parent->color = "black";
-							node_grandpa->color = "red";
+							uncleNode->color = _S_black;
+							node->parent->color = _S_black;
+							node_grandpa->color = _S_red;
 							node = node_grandpa;
 						}
 						else
@@ -528,19 +1527,19 @@ namespace ft
 								node = node->parent;
 								_Rb_tree_right_rotation(node);
 							}
-							node->parent->color = "black";
-							node_grandpa->color = "red";
+							node->parent->color = _S_black;
+							node_grandpa->color = _S_red;
 							_Rb_tree_left_rotation(node_grandpa);
 						}
 					}
 					else
 					{
 						tree_node	*node_uncle = node_grandpa->right;
-						if (node_uncle->color == "red")
+						if (node_uncle->is_red())
 						{
-							node_uncle->color = "black";
-							node->parent->color = "black";
-							node_grandpa->color = "red";
+							node_uncle->color = _S_black;
+							node->parent->color = _S_black;
+							node_grandpa->color = _S_red;
 							node = node_grandpa;
 						}
 						else
@@ -550,46 +1549,49 @@ namespace ft
 								node = node->parent;
 								_Rb_tree_left_rotation(node);
 							}
-							node->parent->color = "black";
-							node_grandpa->color = "red";
+							node->parent->color = _S_black;
+							node_grandpa->color = _S_red;
 							_Rb_tree_right_rotation(node_grandpa);
 						}
 					}                
 				}
-				_root->color = "black";
+				bool	grew = _root->is_red();
+
+				_root->color = _S_black;
+				return (grew);
 			}
 
 			void	_Rb_tree_recolouring(tree_node *node)
 			{
-				while (node != _root && node->color == "black")
+				while (node != _root && node->is_black())
 				{
 					if( node == node->parent->left)
 					{
 						tree_node *sibling = node->parent->right;
-						if (sibling->color == "red")
+						if (sibling->is_red())
 						{
 							_Rb_tree_swap_node_colour(sibling);
-							node->parent->color = "red"; 
+							node->parent->color = _S_red; 
 							_Rb_tree_left_rotation(node->parent);
 							sibling = node->parent->right;
 						}
-						if (sibling->left->color == "black" && sibling->right->color == "black")
+						if (sibling->left->is_black() && sibling->right->is_black())
 						{
-							sibling->color = "red";
+							sibling->color = _S_red;
 							node = node->parent;
 						}
 						else
 						{
-							if (sibling->right->color == "black")
+							if (sibling->right->is_black())
 							{
-								sibling->left->color = "black";
-								sibling->color = "red";
+								sibling->left->color = _S_black;
+								sibling->color = _S_red;
 								_Rb_tree_right_rotation(sibling);
 								sibling = node->parent->right;
 							}
 							sibling->color = node->parent->color;
-							node->parent->color = "black";
-							sibling->right->color = "black";
+							node->parent->color = _S_black;
+							sibling->right->color = _S_black;
 							_Rb_tree_left_rotation(node->parent);
 							node = _root;
 						}
@@ -597,37 +1599,532 @@ namespace ft
 					else
 					{
 						tree_node *sibling = node->parent->left;
-						if (sibling->color == "red")
+						if (sibling->is_red())
 						{
 							_Rb_tree_swap_node_colour(sibling);
-							node->parent->color = "red";
+							node->parent->color = _S_red;
 							_Rb_tree_right_rotation(node->parent);
 							sibling = node->parent->left;
 						}
-						if (sibling->right->color == "black" && sibling->left->color == "black")
+						if (sibling->right->is_black() && sibling->left->is_black())
 						{
-							sibling->color = "red";
+							sibling->color = _S_red;
 							node = node->parent;
 						}
 						else
 						{
-							if (sibling->left->color == "black")
+							if (sibling->left->is_black())
 							{
-								sibling->right->color = "black";
-								sibling->color = "red";
+								sibling->right->color = _S_black;
+								sibling->color = _S_red;
 								_Rb_tree_left_rotation(sibling);
 								sibling = node->parent->left;
 							}
 							sibling->color = node->parent->color;
-							node->parent->color = "black";
-							sibling->left->color = "black";
+							node->parent->color = _S_black;
+							sibling->left->color = _S_black;
 							_Rb_tree_right_rotation(node->parent);
 							node = _root;
 						}
 					}
 				}
-				node->color = "black";
+				node->color = _S_black;
+			}
+
+			/****************************************************************************\
+			**																			**
+			**								Split and join								**
+			**																			**
+			\****************************************************************************/
+
+			/*
+			** Detached subtrees travel as (root, black height) pairs. The black
+			** height counts the black nodes from the root down to nil, the root
+			** included; the root's parent link always points at nil. While a
+			** subtree is being worked on, _root is pointed at it so the regular
+			** rotation and fix-up code can be reused unchanged.
+			*/
+			struct rb_subtree
+			{
+				tree_node	*root;
+				size_type	height;
+			};
+
+			static const size_type	_short_range = 16;
+
+			rb_subtree	make_subtree(tree_node *root, size_type height) const
+			{
+				rb_subtree	t;
+
+				t.root = root;
+				t.height = height;
+				if (root != _node_ptr)
+					root->parent = _node_ptr;
+				return (t);
+			}
+
+			rb_subtree	empty_subtree() const
+			{
+				return (make_subtree(_node_ptr, 0));
+			}
+
+			size_type	black_height(const tree_node *node) const
+			{
+				size_type	height = 0;
+
+				for (; !node->sentinel; node = node->left)
+					height += node->is_black();
+				return (height);
+			}
+
+			rb_subtree	whole() const
+			{
+				return (make_subtree(_root, black_height(_root)));
+			}
+
+			void	set_whole(rb_subtree t)
+			{
+				_root = t.root;
+				_finger = NULL;
+				if (_root == _node_ptr)
+				{
+					leftmost() = _node_ptr;
+					rightmost() = _node_ptr;
+					return ;
+				}
+				_root->parent = _node_ptr;
+				_root->color = _S_black;
+				leftmost() = get_leftmost_node(_root);
+				rightmost() = get_rightmost_node(_root);
+			}
+
+			/*
+			** Turns the two children of node into detached subtrees.
+			*/
+			void	detach_children(tree_node *node, size_type height, rb_subtree &left, rb_subtree &right) const
+			{
+				height -= node->is_black();
+				left = make_subtree(node->left, height);
+				right = make_subtree(node->right, height);
+			}
+
+			/*
+			** Every key of l is below the key of k, itself below every key of r.
+			** The shorter tree is hung, under k, from the spine of the taller one
+			** where the black heights match, then the red k is fixed up as after
+			** an insertion: O(1 + |l.height - r.height|).
+			*/
+			rb_subtree	join(rb_subtree l, tree_node *k, rb_subtree r)
+			{
+				if (l.root->is_red())
+				{
+					l.root->color = _S_black;
+					++l.height;
+				}
+				if (r.root->is_red())
+				{
+					r.root->color = _S_black;
+					++r.height;
+				}
+				k->left = l.root;
+				k->right = r.root;
+				if (l.height == r.height)
+				{
+					k->color = _S_black;
+					k->parent = _node_ptr;
+					if (l.root != _node_ptr)
+						l.root->parent = k;
+					if (r.root != _node_ptr)
+						r.root->parent = k;
+					if (augment_type::enabled)
+						augment_type::update(k);
+					return (make_subtree(k, l.height + 1));
+				}
+
+				bool		taller_left = (l.height > r.height);
+				rb_subtree	tall = taller_left ? l : r;
+				size_type	target = taller_left ? r.height : l.height;
+				tree_node	*parent = _node_ptr;
+				tree_node	*node = tall.root;
+				size_type	height = tall.height;
+
+				while (!(node->is_black() && height == target))
+				{
+					height -= node->is_black();
+					parent = node;
+					node = taller_left ? node->right : node->left;
+				}
+				k->color = _S_red;
+				k->parent = parent;
+				if (taller_left)
+				{
+					k->left = node;
+					parent->right = k;
+				}
+				else
+				{
+					k->right = node;
+					parent->left = k;
+				}
+				if (k->left != _node_ptr)
+					k->left->parent = k;
+				if (k->right != _node_ptr)
+					k->right->parent = k;
+
+				tree_node	*saved = _root;
+
+				_root = tall.root;
+				augment_path(k);
+				tall.height += _Rb_tree_rebalancing(k);
+				tall.root = _root;
+				_root = saved;
+				return (tall);
+			}
+
+			/*
+			** Same as join() without a middle node: the last node of l takes
+			** that role.
+			*/
+			rb_subtree	join2(rb_subtree l, rb_subtree r)
+			{
+				if (l.root == _node_ptr)
+					return (r);
+				if (r.root == _node_ptr)
+					return (l);
+
+				rb_subtree	rest;
+				tree_node	*last = split_last(l, rest);
+
+				return (join(rest, last, r));
+			}
+
+			tree_node	*split_last(rb_subtree t, rb_subtree &rest)
+			{
+				tree_node	*node = t.root;
+				rb_subtree	left;
+				rb_subtree	right;
+
+				detach_children(node, t.height, left, right);
+				if (right.root == _node_ptr)
+				{
+					rest = left;
+					return (node);
+				}
+
+				tree_node	*last = split_last(right, rest);
+
+				rest = join(left, node, rest);
+				return (last);
+			}
+
+			/*
+			** Splits t into the keys below k (l) and above k (r), in O(log n).
+			** Returns the detached node holding k, or NULL.
+			*/
+			template <class K>
+			tree_node	*split(rb_subtree t, const K &k, rb_subtree &l, rb_subtree &r)
+			{
+				if (t.root == _node_ptr)
+				{
+					l = empty_subtree();
+					r = empty_subtree();
+					return (NULL);
+				}
+
+				tree_node	*node = t.root;
+				tree_node	*found;
+				rb_subtree	left;
+				rb_subtree	right;
+
+				detach_children(node, t.height, left, right);
+				if (_comp(k, key(node)))
+				{
+					found = split(left, k, l, r);
+					r = join(r, node, right);
+					return (found);
+				}
+				if (_comp(key(node), k))
+				{
+					found = split(right, k, l, r);
+					l = join(left, node, l);
+					return (found);
+				}
+				l = left;
+				r = right;
+				return (node);
+			}
+
+			/*
+			** The recursive halves of unite(), intersect() and subtract(): t is a
+			** detached subtree of this tree, replaced by the result, src a
+			** subtree of another tree (of black height src_height) that is only
+			** read. If they throw, t is left a valid subtree holding every node
+			** split off on the way down: the halves are joined back around the
+			** key they were split at.
+			*/
+			void	unite(rb_subtree &t, const tree_node *src, size_type src_height, const tree_node *src_nil)
+			{
+				if (src == src_nil)
+					return ;
+				if (t.root == _node_ptr)
+				{
+					tree_node	*copy = _node_ptr;
+
+					try
+					{
+						clone_subtree(src, _node_ptr, src_nil, copy);
+					}
+					catch (...)
+					{
+						delete_subtree(copy);
+						throw ;
+					}
+					t = make_subtree(copy, src_height);
+					return ;
+				}
+
+				rb_subtree	l;
+				rb_subtree	r;
+				size_type	child_height = src_height - src->is_black();
+				tree_node	*found = split(t, key(src), l, r);
+
+				try
+				{
+					unite(l, src->left, child_height, src_nil);
+					unite(r, src->right, child_height, src_nil);
+					if (!found)
+						found = new_node(src->data, _node_ptr);
+				}
+				catch (...)
+				{
+					t = rejoin(l, found, r);
+					throw ;
+				}
+				t = join(l, found, r);
+			}
+
+			void	intersect(rb_subtree &t, const tree_node *src, size_type src_height, const tree_node *src_nil)
+			{
+				if (t.root == _node_ptr)
+					return ;
+				if (src == src_nil)
+				{
+					delete_subtree(t.root);
+					t = empty_subtree();
+					return ;
+				}
+
+				rb_subtree	l;
+				rb_subtree	r;
+				size_type	child_height = src_height - src->is_black();
+				tree_node	*found = split(t, key(src), l, r);
+
+				try
+				{
+					intersect(l, src->left, child_height, src_nil);
+					intersect(r, src->right, child_height, src_nil);
+				}
+				catch (...)
+				{
+					t = rejoin(l, found, r);
+					throw ;
+				}
+				t = rejoin(l, found, r);
+			}
+
+			void	subtract(rb_subtree &t, const tree_node *src, size_type src_height, const tree_node *src_nil)
+			{
+				if (t.root == _node_ptr || src == src_nil)
+					return ;
+
+				rb_subtree	l;
+				rb_subtree	r;
+				size_type	child_height = src_height - src->is_black();
+				tree_node	*found = split(t, key(src), l, r);
+
+				if (found)
+					delete_node(found);
+				try
+				{
+					subtract(l, src->left, child_height, src_nil);
+					subtract(r, src->right, child_height, src_nil);
+				}
+				catch (...)
+				{
+					t = join2(l, r);
+					throw ;
+				}
+				t = join2(l, r);
+			}
+
+			rb_subtree	rejoin(rb_subtree l, tree_node *found, rb_subtree r)
+			{
+				if (found)
+					return (join(l, found, r));
+				return (join2(l, r));
+			}
+
+			/****************************************************************************\
+			**																			**
+			**							Parallel set operations							**
+			**																			**
+			\****************************************************************************/
+
+			enum set_op { _set_union, _set_intersection, _set_difference };
+
+			void	set_op_whole(set_op op, const RBTree &other, unsigned threads)
+			{
+				rb_subtree	t = whole();
+
+				try
+				{
+					parallel_set_op(op, t, other._root, other.black_height(other._root), other._node_ptr, threads);
+				}
+				catch (...)
+				{
+					set_whole(t);
+					throw ;
+				}
+				set_whole(t);
+			}
+
+			void	set_op_sequential(set_op op, rb_subtree &t, const tree_node *src, size_type src_height, const tree_node *src_nil)
+			{
+				if (op == _set_union)
+					unite(t, src, src_height, src_nil);
+				else if (op == _set_intersection)
+					intersect(t, src, src_height, src_nil);
+				else
+					subtract(t, src, src_height, src_nil);
+			}
+
+# if __cplusplus >= 201103L
+			/*
+			** A thread works on its own detached subtree through a worker: a tree
+			** that shares the nil node and the comparator of its owner but has its
+			** own node pool and size, the only state split, join and the node
+			** allocation write to besides the nodes themselves. Once the thread is
+			** joined the owner takes the worker's pool and size delta over (the
+			** delta wraps around when nodes were freed, which the sum undoes).
+			*/
+			struct worker_tag {};
+
+			static const size_type	_parallel_min_height = 8;
+
+			RBTree(const RBTree &owner, worker_tag)
+				: _comp(owner._comp), _node_ptr(owner._node_ptr), _root(_node_ptr), _pool(owner._alloc_pair), _alloc_pair(owner._alloc_pair), _size(0),
+				_finger(NULL), _finger_on(false) {}
+
+			void	retire_worker(RBTree &worker)
+			{
+				_pool.splice(worker._pool);
+				_size += worker._size;
+				worker._node_ptr = NULL;
+			}
+
+			struct set_op_task
+			{
+				RBTree				worker;
+				set_op				op;
+				rb_subtree			t;
+				const tree_node		*src;
+				size_type			src_height;
+				const tree_node		*src_nil;
+				unsigned			threads;
+				std::exception_ptr	error;
+
+				set_op_task(const RBTree &owner, set_op op, rb_subtree t, const tree_node *src, size_type src_height, const tree_node *src_nil, unsigned threads)
+					: worker(owner, worker_tag()), op(op), t(t), src(src), src_height(src_height), src_nil(src_nil), threads(threads), error() {}
+
+				void	run()
+				{
+					try
+					{
+						worker.parallel_set_op(op, t, src, src_height, src_nil, threads);
+					}
+					catch (...)
+					{
+						error = std::current_exception();
+					}
+				}
+			};
+
+			/*
+			** One step of the sequential recursion with the left half handed to
+			** a new thread, which gets threads / 2 of the budget. Small subtrees
+			** of other are not worth a thread and go sequential straight away;
+			** so does a step whose thread cannot be started. On a throw, from
+			** either side, both halves are joined back once the thread is done.
+			*/
+			void	parallel_set_op(set_op op, rb_subtree &t, const tree_node *src, size_type src_height, const tree_node *src_nil, unsigned threads)
+			{
+				if (threads < 2 || src_height < _parallel_min_height || t.root == _node_ptr || src == src_nil)
+				{
+					set_op_sequential(op, t, src, src_height, src_nil);
+					return ;
+				}
+
+				rb_subtree	l;
+				rb_subtree	r;
+				size_type	child_height = src_height - src->is_black();
+				tree_node	*found = split(t, key(src), l, r);
+				set_op_task	task(*this, op, l, src->left, child_height, src_nil, threads / 2);
+				std::thread	thread;
+
+				try
+				{
+					thread = std::thread(&set_op_task::run, &task);
+				}
+				catch (const std::system_error &)
+				{
+					task.run();
+				}
+				try
+				{
+					parallel_set_op(op, r, src->right, child_height, src_nil, threads - threads / 2);
+				}
+				catch (...)
+				{
+					if (thread.joinable())
+						thread.join();
+					retire_worker(task.worker);
+					t = rejoin(task.t, found, r);
+					throw ;
+				}
+				if (thread.joinable())
+					thread.join();
+				retire_worker(task.worker);
+				l = task.t;
+				if (task.error)
+				{
+					t = rejoin(l, found, r);
+					std::rethrow_exception(task.error);
+				}
+				if (op == _set_union && !found)
+				{
+					try
+					{
+						found = new_node(src->data, _node_ptr);
+					}
+					catch (...)
+					{
+						t = join2(l, r);
+						throw ;
+					}
+				}
+				if (op == _set_difference && found)
+				{
+					delete_node(found);
+					found = NULL;
+				}
+				t = rejoin(l, found, r);
+			}
+# else
+			void	parallel_set_op(set_op op, rb_subtree &t, const tree_node *src, size_type src_height, const tree_node *src_nil, unsigned)
+			{
+				set_op_sequential(op, t, src, src_height, src_nil);
 			}
+# endif
 
 		public:
 			/****************************************************************************\
@@ -640,12 +2137,15 @@ namespace ft
 			}
 
 		private:
-			value_compare	_comp;
+			key_compare		_comp;
 			tree_node		*_node_ptr;
 			tree_node		*_root;
 			node_allocator	_alloc_node;
+			node_pool		_pool;
 			allocator_type	_alloc_pair;
 			size_type		_size;
+			mutable tree_node	*_finger;
+			bool			_finger_on;
 	};
 }
 
@@ -0,0 +1,155 @@
+#ifndef _SL_EPOCH_H
+# define _SL_EPOCH_H
+
+# include <atomic>
+# include <cstddef>
+
+namespace ft
+{
+	/*
+	** Epoch-based reclamation for the lock-free containers. A thread pins
+	** the current epoch for as long as it may hold pointers into a shared
+	** structure; a node unlinked during epoch e is retired with that epoch
+	** and may be freed once the global epoch has reached e + 2, as every
+	** thread that could have seen it has unpinned by then. The epoch only
+	** moves on when every pinned thread has observed its current value.
+	**
+	** There is one domain per process and one record per thread, taken on
+	** the thread's first pin and handed back for reuse when it exits.
+	*/
+	class epoch_domain
+	{
+		private:
+			struct record
+			{
+				std::atomic<unsigned long>	local;
+				std::atomic<bool>			in_use;
+				unsigned int				nest;
+				record						*next;
+
+				record() : local(0), in_use(true), nest(0), next(NULL) {}
+			};
+
+			struct record_holder
+			{
+				record	*rec;
+
+				record_holder() : rec(NULL) {}
+
+				~record_holder()
+				{
+					if (rec)
+						rec->in_use.store(false, std::memory_order_release);
+				}
+			};
+
+		public:
+			static epoch_domain	&instance()
+			{
+				static epoch_domain	domain;
+
+				return (domain);
+			}
+
+			/*
+			** Pins are counted, so they nest; only the outermost one publishes
+			** the epoch. The stored value is (epoch << 1) | 1 while pinned.
+			*/
+			void	enter()
+			{
+				record	*rec = local_record();
+
+				if (rec->nest++ == 0)
+					rec->local.store(_epoch.load() << 1 | 1);
+			}
+
+			void	exit()
+			{
+				record	*rec = local_record();
+
+				if (--rec->nest == 0)
+					rec->local.store(0, std::memory_order_release);
+			}
+
+			unsigned long	epoch() const
+			{
+				return (_epoch.load());
+			}
+
+			/*
+			** Moves the epoch on if no pinned thread lags behind it.
+			*/
+			bool	try_advance()
+			{
+				unsigned long	current = _epoch.load();
+
+				for (record *rec = _records.load(std::memory_order_acquire); rec; rec = rec->next)
+				{
+					unsigned long	local = rec->local.load();
+
+					if ((local & 1) && (local >> 1) != current)
+						return (false);
+				}
+				return (_epoch.compare_exchange_strong(current, current + 1));
+			}
+
+		private:
+			epoch_domain() : _epoch(2), _records(NULL) {}
+
+			epoch_domain(const epoch_domain &);
+			epoch_domain	&operator=(const epoch_domain &);
+
+			record	*local_record()
+			{
+				static thread_local record_holder	holder;
+
+				if (!holder.rec)
+					holder.rec = acquire_record();
+				return (holder.rec);
+			}
+
+			/*
+			** Records are never freed: a thread takes over one left by an
+			** exited thread, or pushes a new one on the registry.
+			*/
+			record	*acquire_record()
+			{
+				for (record *rec = _records.load(std::memory_order_acquire); rec; rec = rec->next)
+				{
+					bool	free = false;
+
+					if (!rec->in_use.load(std::memory_order_relaxed)
+						&& rec->in_use.compare_exchange_strong(free, true))
+						return (rec);
+				}
+
+				record	*rec = new record;
+
+				rec->next = _records.load(std::memory_order_relaxed);
+				while (!_records.compare_exchange_weak(rec->next, rec))
+					;
+				return (rec);
+			}
+
+			std::atomic<unsigned long>	_epoch;
+			std::atomic<record *>		_records;
+	};
+
+	/*
+	** Keeps the calling thread pinned for its lifetime. Guards belong to
+	** the thread that built them.
+	*/
+	class epoch_guard
+	{
+		public:
+			epoch_guard() { epoch_domain::instance().enter(); }
+
+			epoch_guard(const epoch_guard &) { epoch_domain::instance().enter(); }
+
+			~epoch_guard() { epoch_domain::instance().exit(); }
+
+			epoch_guard	&operator=(const epoch_guard &) { return (*this); }
+	};
+}
+
+#endif
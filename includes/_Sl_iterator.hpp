@@ -0,0 +1,100 @@
+#ifndef SL_ITERATOR_H
+# define SL_ITERATOR_H
+
+# include <memory>
+# include <iterator>
+# include "_Sl_node.hpp"
+# include "_Sl_epoch.hpp"
+
+namespace ft
+{
+	/*
+	** Forward iterator over the bottom level of the skiplist. It pins the
+	** epoch of the thread that made it, so the node it stands on is never
+	** freed under it, even once erased: ++ then carries on from the links
+	** the node had when it was erased, to the next element still in the
+	** list. Elements inserted or erased ahead of an iterator may or may not
+	** be seen by it. A live iterator holds back reclamation, so do not keep
+	** one around, and do not hand one to another thread.
+	*/
+	template <class T>
+	class SLIterator
+	{
+	public:
+		typedef T								value_type;
+		typedef std::forward_iterator_tag		iterator_category;
+		typedef SLNode<T>						list_node;
+		typedef ptrdiff_t						difference_type;
+		typedef const T&						reference;
+		typedef const T&						const_reference;
+		typedef const T*						pointer;
+		typedef const T*						const_pointer;
+
+	private:
+		const list_node	*node;
+		epoch_guard		guard;
+
+	public:
+		SLIterator() : node(NULL), guard() {}
+
+		explicit SLIterator(const list_node *node) : node(node), guard() {}
+
+		SLIterator(SLIterator const &other) : node(other.node), guard() {}
+
+		SLIterator	&operator=(SLIterator const &other)
+		{
+			node = other.node;
+			return (*this);
+		}
+
+		/*
+		** node, or the first element after it that is not erased.
+		*/
+		static const list_node	*first_live(const list_node *node)
+		{
+			while (node && list_node::marked(node->next[0].load(std::memory_order_acquire)))
+				node = list_node::target(node->next[0].load(std::memory_order_acquire));
+			return (node);
+		}
+
+		const list_node	*base() const
+		{
+			return (node);
+		}
+
+		reference	operator*() const
+		{
+			return (node->data);
+		}
+
+		pointer	operator->() const
+		{
+			return &(node->data);
+		}
+
+		SLIterator	&operator++()
+		{
+			node = first_live(list_node::target(node->next[0].load(std::memory_order_acquire)));
+			return (*this);
+		}
+
+		SLIterator	operator++(int)
+		{
+			SLIterator	tmp(*this);
+			operator++();
+			return (tmp);
+		}
+
+		bool	operator==(SLIterator const &other) const
+		{
+			return (node == other.node);
+		}
+
+		bool	operator!=(SLIterator const &other) const
+		{
+			return (!(*this == other));
+		}
+	};
+}
+
+#endif
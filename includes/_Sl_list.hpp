@@ -0,0 +1,531 @@
+#ifndef _SL_LIST_H
+# define _SL_LIST_H
+
+# include <new>
+# include <atomic>
+# include <memory>
+# include <limits>
+# include "utilities.hpp"
+# include "pair.hpp"
+# include "_Sl_node.hpp"
+# include "_Sl_epoch.hpp"
+# include "_Sl_iterator.hpp"
+
+namespace ft
+{
+	/*
+	** Lock-free skiplist (Herlihy and Shavit's, with Fraser's handling of
+	** upper levels). Every operation may run concurrently with any other
+	** but the destructor, and none of them blocks:
+	**
+	** - lookups walk down the levels without writing anything, stepping
+	**   over the nodes marked as erased;
+	** - insert links a node at the bottom level with one CAS, which is
+	**   when it takes effect, then links it level by level upwards;
+	** - erase marks the node's links from the top down, and marking the
+	**   bottom one is when it takes effect; the node is then unlinked by
+	**   whichever search next walks past it.
+	**
+	** Unlinked nodes are retired to an epoch-stamped limbo list and freed
+	** once no thread can still hold them (see _Sl_epoch.hpp). The allocator
+	** has to be thread-safe.
+	*/
+	template <class Key, class T, class KeyOfValue, class Compare = std::less<Key>, class Allocator = std::allocator<T> >
+	class SkipList
+	{
+		public:
+			typedef Key														key_type;
+			typedef T														value_type;
+			typedef KeyOfValue												key_of_value;
+			typedef Compare													key_compare;
+			typedef Allocator												allocator_type;
+			typedef size_t													size_type;
+			typedef ptrdiff_t												difference_type;
+			typedef SLIterator<value_type>									const_iterator;
+			typedef SLNode<value_type>										list_node;
+			typedef typename Allocator::template rebind<list_node>::other	node_allocator;
+
+			/*
+			** Heights are drawn with p = 1/4, so 16 levels keep searches
+			** logarithmic up to 4^16 elements.
+			*/
+			static const int	max_height = 16;
+
+		private:
+			static const unsigned int	_reclaim_period = 64;
+
+		public:
+			/****************************************************************************\
+			**								Member functions							**
+			\****************************************************************************/
+
+			explicit SkipList(const key_compare &comp, const allocator_type &alloc)
+				: _comp(comp), _size(0), _top(1), _limbo(NULL), _retired(0), _alloc_node(alloc), _alloc(alloc)
+			{
+				for (int i = 0; i < max_height; ++i)
+					_head[i].store(0, std::memory_order_relaxed);
+			}
+
+			~SkipList()
+			{
+				list_node	*node = list_node::target(_head[0].load());
+
+				while (node)
+				{
+					list_node	*next = list_node::target(node->next[0].load());
+
+					destroy_node(node);
+					node = next;
+				}
+				purge(_limbo.exchange(NULL), std::numeric_limits<unsigned long>::max());
+			}
+
+			allocator_type	get_allocator() const
+			{
+				return (_alloc);
+			}
+
+			/****************************************************************************\
+			**									Iterators								**
+			\****************************************************************************/
+
+			const_iterator	begin() const
+			{
+				epoch_guard	guard;
+
+				return (const_iterator(const_iterator::first_live(list_node::target(_head[0].load(std::memory_order_acquire)))));
+			}
+
+			const_iterator	end() const
+			{
+				return (const_iterator());
+			}
+
+			/****************************************************************************\
+			**									Capacity								**
+			\****************************************************************************/
+
+			bool	empty() const
+			{
+				epoch_guard	guard;
+
+				return (!const_iterator::first_live(list_node::target(_head[0].load(std::memory_order_acquire))));
+			}
+
+			/*
+			** Counts the inserts and erases that took effect; exact when the
+			** list is quiet. An erase may be counted before the insert it
+			** undoes, hence the signed counter.
+			*/
+			size_type	size() const
+			{
+				difference_type	size = _size.load(std::memory_order_relaxed);
+
+				return (size > 0 ? size : 0);
+			}
+
+			size_type	max_size() const { return std::min<size_type>(_alloc_node.max_size(),
+									std::numeric_limits<difference_type>::max()); }
+
+			/****************************************************************************\
+			**									Modifiers								**
+			\****************************************************************************/
+
+			/*
+			** Erases the elements one by one: concurrent inserts may survive.
+			*/
+			void	clear()
+			{
+				epoch_guard	guard;
+
+				for (const list_node *node = const_iterator::first_live(list_node::target(_head[0].load())); node;
+					node = const_iterator::first_live(list_node::target(node->next[0].load())))
+					erase(key(node));
+			}
+
+			/*
+			** Orders the list by comp from now on; only for an empty list that
+			** no other thread is using.
+			*/
+			void	key_comp(const key_compare &comp)
+			{
+				_comp = comp;
+			}
+
+			ft::pair<const_iterator, bool>	insert(const value_type &data)
+			{
+				epoch_guard		guard;
+				const key_type	&k = key_of_value()(data);
+				list_node		*preds[max_height];
+				list_node		*succs[max_height];
+				list_node		*node = NULL;
+
+				for (;;)
+				{
+					if (search(k, preds, succs))
+					{
+						if (node)
+							destroy_node(node);
+						return (ft::make_pair(const_iterator(succs[0]), false));
+					}
+					if (!node)
+						node = create_node(data, random_height());
+					for (int i = 0; i < node->height; ++i)
+						node->next[i].store(reinterpret_cast<uintptr_t>(succs[i]), std::memory_order_relaxed);
+
+					uintptr_t	expected = reinterpret_cast<uintptr_t>(succs[0]);
+
+					if (link(preds[0], 0).compare_exchange_strong(expected, reinterpret_cast<uintptr_t>(node)))
+						break;
+				}
+				_size.fetch_add(1, std::memory_order_relaxed);
+				link_upper(node, preds, succs);
+				if (list_node::marked(node->next[0].load()))
+					search(k, preds, succs);
+				release_owner(node);
+				return (ft::make_pair(const_iterator(node), true));
+			}
+
+			template <class K>
+			size_type	erase(const K &k)
+			{
+				epoch_guard	guard;
+				list_node	*preds[max_height];
+				list_node	*succs[max_height];
+
+				if (!search(k, preds, succs))
+					return (0);
+
+				list_node	*node = succs[0];
+
+				for (int i = node->height - 1; i > 0; --i)
+				{
+					uintptr_t	next = node->next[i].load();
+
+					while (!list_node::marked(next) && !node->next[i].compare_exchange_weak(next, next | 1))
+						;
+				}
+
+				uintptr_t	next = node->next[0].load();
+
+				for (;;)
+				{
+					if (list_node::marked(next))
+						return (0);
+					if (node->next[0].compare_exchange_weak(next, next | 1))
+						break;
+				}
+				_size.fetch_sub(1, std::memory_order_relaxed);
+				search(k, preds, succs);
+				release_owner(node);
+				return (1);
+			}
+
+			/****************************************************************************\
+			**									Lookup									**
+			\****************************************************************************/
+
+			template <class K>
+			const_iterator	find(const K &k) const
+			{
+				epoch_guard			guard;
+				const list_node		*node = seek(k, false);
+
+				if (node && !_comp(k, key(node)))
+					return (const_iterator(node));
+				return (end());
+			}
+
+			template <class K>
+			bool	contains(const K &k) const
+			{
+				epoch_guard			guard;
+				const list_node		*node = seek(k, false);
+
+				return (node && !_comp(k, key(node)));
+			}
+
+			template <class K>
+			const_iterator	lower_bound(const K &k) const
+			{
+				epoch_guard	guard;
+
+				return (const_iterator(seek(k, false)));
+			}
+
+			template <class K>
+			const_iterator	upper_bound(const K &k) const
+			{
+				epoch_guard	guard;
+
+				return (const_iterator(seek(k, true)));
+			}
+
+			template <class K>
+			ft::pair<const_iterator, const_iterator>	equal_range(const K &k) const
+			{
+				epoch_guard		guard;
+				const_iterator	first = lower_bound(k);
+				const_iterator	last = first;
+
+				if (first != end() && !_comp(k, key_of_value()(*first)))
+					++last;
+				return (ft::make_pair(first, last));
+			}
+
+		private:
+			SkipList(const SkipList &);
+			SkipList	&operator=(const SkipList &);
+
+			/****************************************************************************\
+			**										Node								**
+			\****************************************************************************/
+
+			static const key_type	&key(const list_node *node)
+			{
+				return (key_of_value()(node->data));
+			}
+
+			/*
+			** The links of pred at level i, the head's when pred is NULL.
+			*/
+			std::atomic<uintptr_t>	&link(const list_node *pred, int i) const
+			{
+				return (pred ? const_cast<list_node *>(pred)->next[i] : _head[i]);
+			}
+
+			static size_type	slots(unsigned char height)
+			{
+				return ((list_node::bytes(height) + sizeof(list_node) - 1) / sizeof(list_node));
+			}
+
+			list_node	*create_node(const value_type &data, unsigned char height)
+			{
+				list_node	*node = _alloc_node.allocate(slots(height));
+
+				try
+				{
+					::new (static_cast<void *>(node)) list_node(data, height);
+				}
+				catch (...)
+				{
+					_alloc_node.deallocate(node, slots(height));
+					throw;
+				}
+
+				int	top = _top.load(std::memory_order_relaxed);
+
+				while (top < height && !_top.compare_exchange_weak(top, height))
+					;
+				return (node);
+			}
+
+			void	destroy_node(list_node *node)
+			{
+				unsigned char	height = node->height;
+
+				node->~list_node();
+				_alloc_node.deallocate(node, slots(height));
+			}
+
+			/*
+			** A thread-local xorshift: two bits per level gives p = 1/4.
+			*/
+			static unsigned char	random_height()
+			{
+				static std::atomic<unsigned int>	seeds(0x9e3779b9u);
+				static thread_local unsigned int	state = seeds.fetch_add(0x9e3779b9u) | 1;
+				unsigned char						height = 1;
+
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+				for (unsigned int bits = state; height < max_height && !(bits & 3); bits >>= 2)
+					++height;
+				return (height);
+			}
+
+			/****************************************************************************\
+			**									Searching								**
+			\****************************************************************************/
+
+			/*
+			** Fills preds and succs with the nodes on either side of k at every
+			** level, unlinking the erased nodes met on the way; succs[i] is
+			** the first node at level i not below k. Starts over whenever an
+			** unlink fails, as the predecessor is then being erased too.
+			*/
+			template <class K>
+			bool	search(const K &k, list_node **preds, list_node **succs)
+			{
+			retry:
+				list_node	*pred = NULL;
+				int			top = _top.load();
+
+				for (int i = max_height - 1; i >= top; --i)
+				{
+					preds[i] = NULL;
+					succs[i] = NULL;
+				}
+				for (int i = top - 1; i >= 0; --i)
+				{
+					list_node	*curr = list_node::target(link(pred, i).load());
+
+					while (curr)
+					{
+						uintptr_t	succ = curr->next[i].load();
+
+						if (list_node::marked(succ))
+						{
+							uintptr_t	expected = reinterpret_cast<uintptr_t>(curr);
+
+							if (!link(pred, i).compare_exchange_strong(expected, succ & ~static_cast<uintptr_t>(1)))
+								goto retry;
+							curr = list_node::target(succ);
+							continue;
+						}
+						if (!_comp(key(curr), k))
+							break;
+						pred = curr;
+						curr = list_node::target(succ);
+					}
+					preds[i] = pred;
+					succs[i] = curr;
+				}
+				return (succs[0] && !_comp(k, key(succs[0])));
+			}
+
+			/*
+			** The first live node not below k, or above k with after: a read
+			** only descent that steps over erased nodes instead of unlinking
+			** them.
+			*/
+			template <class K>
+			const list_node	*seek(const K &k, bool after) const
+			{
+				const list_node	*pred = NULL;
+				const list_node	*curr = NULL;
+
+				for (int i = _top.load(std::memory_order_acquire) - 1; i >= 0; --i)
+				{
+					curr = list_node::target(link(pred, i).load(std::memory_order_acquire));
+					while (curr)
+					{
+						uintptr_t	succ = curr->next[i].load(std::memory_order_acquire);
+
+						if (!list_node::marked(succ))
+						{
+							if (after ? _comp(k, key(curr)) : !_comp(key(curr), k))
+								break;
+							pred = curr;
+						}
+						curr = list_node::target(succ);
+					}
+				}
+				return (curr);
+			}
+
+			/*
+			** Links node above the bottom level, where it is already in. Gives
+			** up as soon as node gets erased: the eraser's search, or ours in
+			** insert(), unlinks whatever was linked.
+			*/
+			void	link_upper(list_node *node, list_node **preds, list_node **succs)
+			{
+				const key_type	&k = key(node);
+
+				for (int i = 1; i < node->height; ++i)
+				{
+					for (;;)
+					{
+						uintptr_t	next = node->next[i].load();
+						uintptr_t	succ = reinterpret_cast<uintptr_t>(succs[i]);
+
+						if (list_node::marked(next))
+							return ;
+						if (next != succ && !node->next[i].compare_exchange_strong(next, succ))
+							return ;
+						if (link(preds[i], i).compare_exchange_strong(succ, reinterpret_cast<uintptr_t>(node)))
+							break;
+						if (!search(k, preds, succs) || succs[0] != node)
+							return ;
+					}
+				}
+			}
+
+			/****************************************************************************\
+			**									Reclamation								**
+			\****************************************************************************/
+
+			/*
+			** Called by the inserting and the erasing thread when each is done
+			** with node; the second one retires it.
+			*/
+			void	release_owner(list_node *node)
+			{
+				if (node->owners.fetch_sub(1, std::memory_order_acq_rel) == 1)
+					retire(node);
+			}
+
+			void	retire(list_node *node)
+			{
+				node->retired_epoch = epoch_domain::instance().epoch();
+				node->retired_next = _limbo.load(std::memory_order_relaxed);
+				while (!_limbo.compare_exchange_weak(node->retired_next, node))
+					;
+				if (_retired.fetch_add(1, std::memory_order_relaxed) % _reclaim_period == _reclaim_period - 1)
+					reclaim();
+			}
+
+			/*
+			** Takes the whole limbo list, frees what is old enough and puts the
+			** rest back.
+			*/
+			void	reclaim()
+			{
+				epoch_domain	&domain = epoch_domain::instance();
+
+				domain.try_advance();
+				purge(_limbo.exchange(NULL), domain.epoch());
+			}
+
+			void	purge(list_node *node, unsigned long epoch)
+			{
+				list_node	*keep = NULL;
+				list_node	*last = NULL;
+
+				while (node)
+				{
+					list_node	*next = node->retired_next;
+
+					if (node->retired_epoch + 2 <= epoch)
+						destroy_node(node);
+					else
+					{
+						node->retired_next = keep;
+						keep = node;
+						if (!last)
+							last = node;
+					}
+					node = next;
+				}
+				if (!keep)
+					return ;
+				last->retired_next = _limbo.load(std::memory_order_relaxed);
+				while (!_limbo.compare_exchange_weak(last->retired_next, keep))
+					;
+			}
+
+		private:
+			key_compare							_comp;
+			mutable std::atomic<uintptr_t>		_head[max_height];
+			std::atomic<difference_type>		_size;
+			std::atomic<int>					_top;
+			std::atomic<list_node *>			_limbo;
+			std::atomic<unsigned int>			_retired;
+			node_allocator						_alloc_node;
+			allocator_type						_alloc;
+	};
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef _SL_NODE_H
+# define _SL_NODE_H
+
+# include <new>
+# include <atomic>
+# include <cstddef>
+# include <stdint.h>
+
+namespace ft {
+
+	/*
+	** Node of the lock-free skiplist. A node of height h is allocated with
+	** room for h links: next[] runs past the end of the struct. The low bit
+	** of next[i] marks the node as deleted at level i, so that a CAS on a
+	** predecessor's link fails if the predecessor is going away.
+	**
+	** owners starts at two, the inserting and the erasing thread: the last
+	** of them to be done with the node retires it, which keeps it alive
+	** while a slow inserter may still link it at its upper levels.
+	*/
+	template <class T>
+	struct SLNode
+	{
+		typedef T	value_type;
+
+		value_type					data;
+		SLNode						*retired_next;
+		unsigned long				retired_epoch;
+		std::atomic<int>			owners;
+		unsigned char				height;
+		std::atomic<uintptr_t>		next[1];
+
+		SLNode(const value_type &data, unsigned char height)
+			: data(data), retired_next(NULL), retired_epoch(0), owners(2), height(height)
+		{
+			for (unsigned char i = 1; i < height; ++i)
+				::new (static_cast<void *>(&next[i])) std::atomic<uintptr_t>(0);
+			next[0].store(0, std::memory_order_relaxed);
+		}
+
+		static size_t	bytes(unsigned char height)
+		{
+			return (sizeof(SLNode) + (height - 1) * sizeof(std::atomic<uintptr_t>));
+		}
+
+		static bool	marked(uintptr_t link)
+		{
+			return (link & 1);
+		}
+
+		static SLNode	*target(uintptr_t link)
+		{
+			return (reinterpret_cast<SLNode *>(link & ~static_cast<uintptr_t>(1)));
+		}
+
+	private:
+		SLNode(const SLNode &);
+		SLNode	&operator=(const SLNode &);
+	};
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef SW_GROUP_H
+# define SW_GROUP_H
+
+# include <cstddef>
+# if defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+
+namespace ft
+{
+	/*
+	** Control bytes of a Swiss table (see _Sw_table.hpp), one per slot: a
+	** full slot holds the low 7 bits of its hash, the other states are
+	** negative so that a single signed compare tells them apart.
+	*/
+	typedef signed char	sw_ctrl;
+
+	static const sw_ctrl	sw_empty = -128;
+	static const sw_ctrl	sw_deleted = -2;
+	static const sw_ctrl	sw_sentinel = -1;
+
+	/*
+	** A set of slots in a group, one bit each, walked lowest first.
+	*/
+	class sw_bitmask
+	{
+		public:
+			explicit sw_bitmask(unsigned bits) : _bits(bits) {}
+
+			operator bool() const { return (_bits != 0); }
+
+			unsigned	lowest() const
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				return (__builtin_ctz(_bits));
+#else
+				unsigned	n = 0;
+
+				while (!(_bits >> n & 1))
+					++n;
+				return (n);
+#endif
+			}
+
+			/*
+			** Clear bits below the lowest set one and above the highest, out
+			** of 16: how far the slots around a position go without one the
+			** mask picks.
+			*/
+			unsigned	trailing_zeros() const
+			{
+				return (_bits ? lowest() : 16);
+			}
+
+			unsigned	leading_zeros() const
+			{
+				unsigned	n = 0;
+
+				while (n < 16 && !(_bits >> (15 - n) & 1))
+					++n;
+				return (n);
+			}
+
+			sw_bitmask	&operator++()
+			{
+				_bits &= _bits - 1;
+				return (*this);
+			}
+
+		private:
+			unsigned	_bits;
+	};
+
+	/*
+	** Sixteen control bytes read at once: with SSE2 each question is one
+	** compare and one movemask, otherwise a loop over the bytes.
+	*/
+	class sw_group
+	{
+		public:
+			static const size_t	width = 16;
+
+#if defined(__SSE2__)
+			explicit sw_group(const sw_ctrl *ctrl) : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl))) {}
+
+			sw_bitmask	match(sw_ctrl h2) const
+			{
+				return (sw_bitmask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl))));
+			}
+
+			sw_bitmask	match_empty() const
+			{
+				return (sw_bitmask(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(sw_empty), _ctrl))));
+			}
+
+			sw_bitmask	match_empty_or_deleted() const
+			{
+				return (sw_bitmask(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(sw_sentinel), _ctrl))));
+			}
+
+		private:
+			__m128i	_ctrl;
+#else
+			explicit sw_group(const sw_ctrl *ctrl) : _ctrl(ctrl) {}
+
+			sw_bitmask	match(sw_ctrl h2) const
+			{
+				unsigned	bits = 0;
+
+				for (size_t i = 0; i < width; ++i)
+					bits |= static_cast<unsigned>(_ctrl[i] == h2) << i;
+				return (sw_bitmask(bits));
+			}
+
+			sw_bitmask	match_empty() const
+			{
+				return (match(sw_empty));
+			}
+
+			sw_bitmask	match_empty_or_deleted() const
+			{
+				unsigned	bits = 0;
+
+				for (size_t i = 0; i < width; ++i)
+					bits |= static_cast<unsigned>(_ctrl[i] < sw_sentinel) << i;
+				return (sw_bitmask(bits));
+			}
+
+		private:
+			const sw_ctrl	*_ctrl;
+#endif
+	};
+}
+
+#endif
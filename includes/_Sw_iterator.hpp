@@ -0,0 +1,109 @@
+#ifndef SW_ITERATOR_H
+# define SW_ITERATOR_H
+
+# include <memory>
+# include <iterator>
+# include <cstddef>
+# include "_Sw_group.hpp"
+
+namespace ft
+{
+	/*
+	** A slot of a Swiss table with the control byte that goes with it;
+	** stepping skips the slots that are not full, and stops on the
+	** sentinel byte past the last slot, which is end(). Any rehash
+	** invalidates iterators; an erasure only those on the erased element.
+	*/
+	template <class I>
+	class SWIterator
+	{
+	public:
+		typedef I								value_type;
+		typedef std::forward_iterator_tag		iterator_category;
+		typedef ptrdiff_t						difference_type;
+		typedef I&								reference;
+		typedef const I&						const_reference;
+		typedef I*								pointer;
+		typedef const I*						const_pointer;
+
+		typedef SWIterator<I>					iterator;
+		typedef SWIterator<const I>				const_iterator;
+
+	private:
+		const sw_ctrl	*ctrl;
+		I				*slot;
+
+	public:
+		SWIterator() : ctrl(NULL), slot(NULL) {}
+
+		SWIterator(const sw_ctrl *ctrl, I *slot) : ctrl(ctrl), slot(slot) {}
+
+		SWIterator(SWIterator const &other) : ctrl(other.ctrl), slot(other.slot) {}
+
+		SWIterator	&operator=(SWIterator const &other)
+		{
+			ctrl = other.ctrl;
+			slot = other.slot;
+			return (*this);
+		}
+
+		operator	const_iterator() const
+		{
+			return (const_iterator(ctrl, slot));
+		}
+
+		const sw_ctrl	*base() const
+		{
+			return (ctrl);
+		}
+
+		reference	operator*() const
+		{
+			return (*slot);
+		}
+
+		pointer	operator->() const
+		{
+			return (slot);
+		}
+
+		/*
+		** Moves to the first full slot from here on, or to end().
+		*/
+		SWIterator	&skip_free()
+		{
+			while (ctrl && *ctrl < sw_sentinel)
+			{
+				++ctrl;
+				++slot;
+			}
+			return (*this);
+		}
+
+		SWIterator	&operator++()
+		{
+			++ctrl;
+			++slot;
+			return (skip_free());
+		}
+
+		SWIterator	operator++(int)
+		{
+			SWIterator	tmp(*this);
+			operator++();
+			return (tmp);
+		}
+
+		bool	operator==(SWIterator const &other) const
+		{
+			return (ctrl == other.ctrl);
+		}
+
+		bool	operator!=(SWIterator const &other) const
+		{
+			return (!(*this == other));
+		}
+	};
+}
+
+#endif
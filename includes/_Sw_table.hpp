@@ -0,0 +1,697 @@
+#ifndef _SW_TABLE_H
+# define _SW_TABLE_H
+
+# include <new>
+# include <memory>
+# include <limits>
+# include <cstring>
+# include <functional>
+# include "utilities.hpp"
+# include "pair.hpp"
+# include "_Sw_group.hpp"
+# include "_Sw_iterator.hpp"
+
+namespace ft
+{
+	/*
+	** Open-addressing hash table in the Swiss table layout, the engine of
+	** unordered_map and unordered_set. Key, T and KeyOfValue play the same
+	** roles as in RBTree; Hash and KeyEqual those of the std unordered
+	** containers.
+	**
+	** Values sit directly in one array of slots, and each slot has a
+	** control byte in a parallel array (see _Sw_group.hpp). The hash is
+	** split in two: its high bits, h1, pick where the probe starts, and its
+	** low 7 bits, h2, go in the control byte. A probe reads 16 control
+	** bytes at once and only compares keys in the slots whose byte equals
+	** h2, about one in 128 of the wrong ones; it stops at the first group
+	** with an empty slot. Groups are visited in triangular steps, which
+	** reach every group of a power-of-two table.
+	**
+	** The capacity is a power of two minus one, the byte after the last
+	** slot is a sentinel that ends iteration, and the first 15 control
+	** bytes are cloned after it so that a group can be read from any slot
+	** without wrapping. Erasing leaves a tombstone only when some probe may
+	** have gone past the slot, i.e. when it sits in a run of 16 slots none
+	** of which is empty.
+	*/
+	template <class Key, class T, class KeyOfValue, class Hash = std::hash<Key>, class KeyEqual = ft::equal_to<Key>,
+		class Allocator = std::allocator<T> >
+	class SWTable
+	{
+		public:
+			typedef Key															key_type;
+			typedef T															value_type;
+			typedef KeyOfValue													key_of_value;
+			typedef Hash														hasher;
+			typedef KeyEqual													key_equal;
+			typedef Allocator													allocator_type;
+			typedef size_t														size_type;
+			typedef ptrdiff_t													difference_type;
+			typedef typename allocator_type::reference							reference;
+			typedef typename allocator_type::const_reference					const_reference;
+			typedef typename allocator_type::pointer							pointer;
+			typedef typename allocator_type::const_pointer						const_pointer;
+			typedef SWIterator<value_type>										iterator;
+			typedef SWIterator<const value_type>								const_iterator;
+			typedef typename Allocator::template rebind<sw_ctrl>::other			ctrl_allocator;
+
+		private:
+			static const size_type	_min_capacity = sw_group::width - 1;
+
+		public:
+			/****************************************************************************\
+			**								Member functions							**
+			\****************************************************************************/
+
+			SWTable(size_type buckets, const hasher &hash, const key_equal &eq, const allocator_type &alloc)
+				: _hash(hash), _eq(eq), _alloc(alloc), _alloc_ctrl(alloc), _ctrl(NULL), _slots(NULL),
+				_capacity(0), _size(0), _growth_left(0), _max_load(0.875f)
+			{
+				if (buckets)
+					resize(normalize(buckets));
+			}
+
+			/*
+			** Copies slot for slot, control bytes and all: nothing is hashed.
+			*/
+			SWTable(const SWTable &other)
+				: _hash(other._hash), _eq(other._eq), _alloc(other._alloc), _alloc_ctrl(other._alloc_ctrl), _ctrl(NULL), _slots(NULL),
+				_capacity(0), _size(0), _growth_left(0), _max_load(other._max_load)
+			{
+				size_type	i = 0;
+
+				if (!other._capacity)
+					return ;
+				allocate(other._capacity);
+				std::memcpy(_ctrl, other._ctrl, ctrl_bytes(_capacity));
+				try
+				{
+					for (; i < _capacity; ++i)
+						if (is_full(_ctrl[i]))
+							_alloc.construct(_slots + i, other._slots[i]);
+				}
+				catch (...)
+				{
+					while (i--)
+						if (is_full(_ctrl[i]))
+							_alloc.destroy(_slots + i);
+					deallocate();
+					throw;
+				}
+				_size = other._size;
+				_growth_left = other._growth_left;
+			}
+
+			SWTable	&operator=(const SWTable &other)
+			{
+				if (this != &other)
+				{
+					SWTable	tmp(other);
+
+					swap(tmp);
+				}
+				return (*this);
+			}
+
+			~SWTable()
+			{
+				destroy_all();
+				deallocate();
+			}
+
+			/****************************************************************************\
+			**									Iterators								**
+			\****************************************************************************/
+
+			iterator	begin()
+			{
+				return (iterator(_ctrl, _slots).skip_free());
+			}
+
+			const_iterator	begin() const
+			{
+				return (const_iterator(_ctrl, _slots).skip_free());
+			}
+
+			iterator	end()
+			{
+				return (iterator(_ctrl + _capacity, _slots + _capacity));
+			}
+
+			const_iterator	end() const
+			{
+				return (const_iterator(_ctrl + _capacity, _slots + _capacity));
+			}
+
+			/****************************************************************************\
+			**									Capacity								**
+			\****************************************************************************/
+
+			bool	empty() const
+			{
+				return (!_size);
+			}
+
+			size_type	size() const
+			{
+				return (_size);
+			}
+
+			size_type	max_size() const
+			{
+				return (std::min<size_type>(_alloc.max_size(), std::numeric_limits<difference_type>::max()));
+			}
+
+			/****************************************************************************\
+			**									Modifiers								**
+			\****************************************************************************/
+
+			/*
+			** Keeps the slots, as the table is likely to fill up again.
+			*/
+			void	clear()
+			{
+				destroy_all();
+				if (_capacity)
+					reset_ctrl();
+				_size = 0;
+				_growth_left = limit(_capacity);
+			}
+
+			ft::pair<iterator, bool>	insert(const value_type &data)
+			{
+				size_type	pos;
+
+				if (find_or_prepare_insert(key_of_value()(data), pos))
+					return (ft::make_pair(iterator_at(pos), false));
+				return (ft::make_pair(insert_at(pos, data), true));
+			}
+
+			template <class InputIt>
+			void	insert(InputIt first, InputIt last,
+				typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+			{
+				while (first != last)
+					insert(*first++);
+			}
+
+			/*
+			** Single-probe building blocks for try_emplace() and the like:
+			** find_or_prepare_insert() returns true and the slot of k when k is
+			** there; otherwise it returns false and claims a free slot for k,
+			** growing the table if needed, which insert_at() or emplace_at()
+			** must then fill. They give the slot back if the value throws.
+			*/
+			template <class K>
+			bool	find_or_prepare_insert(const K &k, size_type &pos)
+			{
+				const unsigned long long	h = mix(k);
+
+				if (probe(k, h, pos))
+					return (true);
+				pos = prepare_insert(h);
+				return (false);
+			}
+
+			iterator	insert_at(size_type pos, const value_type &data)
+			{
+				try
+				{
+					_alloc.construct(_slots + pos, data);
+				}
+				catch (...)
+				{
+					release(pos);
+					throw;
+				}
+				return (iterator_at(pos));
+			}
+
+			template <class A1, class A2>
+			iterator	emplace_at(size_type pos, const A1 &first, const A2 &second)
+			{
+				try
+				{
+					::new (static_cast<void *>(_slots + pos)) value_type(first, second);
+				}
+				catch (...)
+				{
+					release(pos);
+					throw;
+				}
+				return (iterator_at(pos));
+			}
+
+			/*
+			** find_or_prepare_insert() and emplace_at() in one go, for arguments
+			** that may be elements of the table: growing frees the old slots,
+			** so when the insert has to grow the table the value is built
+			** first.
+			*/
+			template <class K, class A1, class A2>
+			bool	find_or_emplace(const K &k, size_type &pos, const A1 &first, const A2 &second)
+			{
+				const unsigned long long	h = mix(k);
+
+				if (probe(k, h, pos))
+					return (true);
+				if (must_grow(h))
+				{
+					const value_type	data(first, second);
+
+					pos = prepare_insert(h);
+					insert_at(pos, data);
+				}
+				else
+				{
+					pos = prepare_insert(h);
+					emplace_at(pos, first, second);
+				}
+				return (false);
+			}
+
+			/*
+			** Returns the element that followed pos. Nothing moves, so other
+			** iterators stay valid.
+			*/
+			iterator	erase(const_iterator pos)
+			{
+				const size_type	i = pos.base() - _ctrl;
+
+				_alloc.destroy(_slots + i);
+				release(i);
+				return (iterator_at(i).skip_free());
+			}
+
+			iterator	erase(iterator pos)
+			{
+				return (erase(const_iterator(pos)));
+			}
+
+			iterator	erase(const_iterator first, const_iterator last)
+			{
+				while (first != last)
+					first = erase(first);
+				return (iterator_at(last.base() - _ctrl));
+			}
+
+			template <class K>
+			size_type	erase(const K &k)
+			{
+				size_type	pos;
+
+				if (!probe(k, mix(k), pos))
+					return (0);
+				_alloc.destroy(_slots + pos);
+				release(pos);
+				return (1);
+			}
+
+			void	swap(SWTable &x)
+			{
+				ft::swap_elements(_hash, x._hash);
+				ft::swap_elements(_eq, x._eq);
+				ft::swap_elements(_alloc, x._alloc);
+				ft::swap_elements(_alloc_ctrl, x._alloc_ctrl);
+				ft::swap_elements(_ctrl, x._ctrl);
+				ft::swap_elements(_slots, x._slots);
+				ft::swap_elements(_capacity, x._capacity);
+				ft::swap_elements(_size, x._size);
+				ft::swap_elements(_growth_left, x._growth_left);
+				ft::swap_elements(_max_load, x._max_load);
+			}
+
+			/****************************************************************************\
+			**									Lookup									**
+			\****************************************************************************/
+
+			template <class K>
+			iterator	find(const K &k)
+			{
+				size_type	pos;
+
+				if (!probe(k, mix(k), pos))
+					return (end());
+				return (iterator_at(pos));
+			}
+
+			template <class K>
+			const_iterator	find(const K &k) const
+			{
+				return (const_cast<SWTable *>(this)->find(k));
+			}
+
+			template <class K>
+			ft::pair<iterator, iterator>	equal_range(const K &k)
+			{
+				iterator	first = find(k);
+				iterator	last = first;
+
+				if (first != end())
+					++last;
+				return (ft::make_pair(first, last));
+			}
+
+			template <class K>
+			ft::pair<const_iterator, const_iterator>	equal_range(const K &k) const
+			{
+				ft::pair<iterator, iterator>	range = const_cast<SWTable *>(this)->equal_range(k);
+
+				return (ft::make_pair(const_iterator(range.first), const_iterator(range.second)));
+			}
+
+			/****************************************************************************\
+			**									Hash policy								**
+			\****************************************************************************/
+
+			size_type	bucket_count() const
+			{
+				return (_capacity);
+			}
+
+			float	load_factor() const
+			{
+				return (_capacity ? static_cast<float>(_size) / _capacity : 0.f);
+			}
+
+			float	max_load_factor() const
+			{
+				return (_max_load);
+			}
+
+			/*
+			** Clamped to [1/8, 15/16]: an open-addressing table cannot go
+			** past 1, and probes get long well before.
+			*/
+			void	max_load_factor(float ml)
+			{
+				_max_load = std::max(0.125f, std::min(ml, 0.9375f));
+				if (!_capacity)
+					return ;
+				if (_size > limit(_capacity))
+					resize(capacity_for(_size));
+				else
+					resize(_capacity);
+			}
+
+			/*
+			** At least n slots, and enough for size() under the maximum load
+			** factor; rehash(0) on an empty table frees everything.
+			*/
+			void	rehash(size_type n)
+			{
+				if (!n && !_size)
+				{
+					deallocate();
+					_growth_left = 0;
+					return ;
+				}
+				resize(std::max(normalize(n), capacity_for(_size)));
+			}
+
+			/*
+			** Room for n elements without growing.
+			*/
+			void	reserve(size_type n)
+			{
+				if (n > limit(_capacity))
+					resize(capacity_for(n));
+			}
+
+			hasher	hash_function() const
+			{
+				return (_hash);
+			}
+
+			key_equal	key_eq() const
+			{
+				return (_eq);
+			}
+
+			allocator_type	get_allocator() const
+			{
+				return (_alloc);
+			}
+
+			/*
+			** The element in slot pos, as find_or_prepare_insert() gives it.
+			*/
+			iterator	iterator_at(size_type pos)
+			{
+				return (iterator(_ctrl + pos, _slots + pos));
+			}
+
+		private:
+			static bool	is_full(sw_ctrl c)
+			{
+				return (c >= 0);
+			}
+
+			static size_type	ctrl_bytes(size_type capacity)
+			{
+				return (capacity + sw_group::width);
+			}
+
+			/*
+			** std::hash is the identity on integers here, and h1 and h2 both
+			** need well-spread bits: the hash is mixed first.
+			*/
+			template <class K>
+			unsigned long long	mix(const K &k) const
+			{
+				unsigned long long	h = static_cast<unsigned long long>(_hash(k));
+
+				h ^= h >> 33;
+				h *= 0xff51afd7ed558ccdULL;
+				h ^= h >> 33;
+				return (h);
+			}
+
+			static sw_ctrl	h2(unsigned long long h)
+			{
+				return (static_cast<sw_ctrl>(h & 0x7f));
+			}
+
+			/*
+			** Looks k up; pos is its slot when found.
+			*/
+			template <class K>
+			bool	probe(const K &k, unsigned long long h, size_type &pos) const
+			{
+				size_type	offset = static_cast<size_type>(h >> 7) & _capacity;
+				size_type	step = 0;
+
+				if (!_capacity)
+					return (false);
+				ft::prefetch(_slots + offset);
+				while (true)
+				{
+					const sw_group	group(_ctrl + offset);
+
+					for (sw_bitmask match = group.match(h2(h)); match; ++match)
+					{
+						pos = (offset + match.lowest()) & _capacity;
+						if (_eq(k, key_of_value()(_slots[pos])))
+							return (true);
+					}
+					if (group.match_empty())
+						return (false);
+					step += sw_group::width;
+					offset = (offset + step) & _capacity;
+				}
+			}
+
+			/*
+			** The first empty or deleted slot on the probe sequence of h.
+			*/
+			size_type	find_first_free(unsigned long long h) const
+			{
+				size_type	offset = static_cast<size_type>(h >> 7) & _capacity;
+				size_type	step = 0;
+
+				while (true)
+				{
+					const sw_bitmask	free = sw_group(_ctrl + offset).match_empty_or_deleted();
+
+					if (free)
+						return ((offset + free.lowest()) & _capacity);
+					step += sw_group::width;
+					offset = (offset + step) & _capacity;
+				}
+			}
+
+			/*
+			** Only an empty slot uses up growth: a tombstone is taken back as
+			** is. When the table is out of growth, it doubles, unless
+			** tombstones take up over half the room, in which case rebuilding
+			** at the same size clears them.
+			*/
+			bool	must_grow(unsigned long long h) const
+			{
+				return (!_capacity || (!_growth_left && _ctrl[find_first_free(h)] != sw_deleted));
+			}
+
+			size_type	prepare_insert(unsigned long long h)
+			{
+				if (must_grow(h))
+				{
+					if (!_capacity)
+						resize(_min_capacity);
+					else if (_size * 2 <= limit(_capacity))
+						resize(_capacity);
+					else
+						resize(_capacity * 2 + 1);
+				}
+
+				const size_type	pos = find_first_free(h);
+
+				_growth_left -= (_ctrl[pos] == sw_empty);
+				set_ctrl(pos, h2(h));
+				++_size;
+				return (pos);
+			}
+
+			/*
+			** Frees the control byte of pos, whose value is already gone.
+			*/
+			void	release(size_type pos)
+			{
+				const size_type		before = (pos - sw_group::width) & _capacity;
+				const sw_bitmask	empty_after = sw_group(_ctrl + pos).match_empty();
+				const sw_bitmask	empty_before = sw_group(_ctrl + before).match_empty();
+				const bool			never_full = empty_after.trailing_zeros() + empty_before.leading_zeros() < sw_group::width;
+
+				set_ctrl(pos, never_full ? sw_empty : sw_deleted);
+				_growth_left += never_full;
+				--_size;
+			}
+
+			/*
+			** Also writes the clone of the first 15 bytes; for the others the
+			** second write lands on pos again.
+			*/
+			void	set_ctrl(size_type pos, sw_ctrl c)
+			{
+				_ctrl[pos] = c;
+				_ctrl[((pos - (sw_group::width - 1)) & _capacity) + (sw_group::width - 1)] = c;
+			}
+
+			void	reset_ctrl()
+			{
+				std::memset(_ctrl, sw_empty, ctrl_bytes(_capacity));
+				_ctrl[_capacity] = sw_sentinel;
+			}
+
+			/*
+			** How many elements capacity slots may hold: at least one slot
+			** always stays empty, so that every probe ends.
+			*/
+			size_type	limit(size_type capacity) const
+			{
+				const size_type	n = static_cast<size_type>(capacity * static_cast<double>(_max_load));
+
+				return (capacity ? std::min(n, capacity - 1) : 0);
+			}
+
+			/*
+			** The smallest capacity of the form 2^k - 1 of at least n.
+			*/
+			static size_type	normalize(size_type n)
+			{
+				size_type	capacity = _min_capacity;
+
+				while (capacity < n)
+					capacity = capacity * 2 + 1;
+				return (capacity);
+			}
+
+			size_type	capacity_for(size_type n) const
+			{
+				size_type	capacity = _min_capacity;
+
+				while (limit(capacity) < n)
+					capacity = capacity * 2 + 1;
+				return (capacity);
+			}
+
+			/*
+			** Copies every element into a fresh table of the given capacity,
+			** and only then destroys the old ones: if a copy throws, the table
+			** is left as it was. Tombstones are dropped on the way.
+			*/
+			void	resize(size_type capacity)
+			{
+				SWTable		tmp(0, _hash, _eq, _alloc);
+				size_type	i = 0;
+
+				tmp._max_load = _max_load;
+				tmp.allocate(capacity);
+				tmp._growth_left = tmp.limit(capacity);
+				for (; i < _capacity; ++i)
+				{
+					if (!is_full(_ctrl[i]))
+						continue ;
+
+					const unsigned long long	h = mix(key_of_value()(_slots[i]));
+					const size_type				pos = tmp.find_first_free(h);
+
+					tmp._alloc.construct(tmp._slots + pos, _slots[i]);
+					tmp.set_ctrl(pos, h2(h));
+					++tmp._size;
+					--tmp._growth_left;
+				}
+				swap(tmp);
+			}
+
+			void	destroy_all()
+			{
+				for (size_type i = 0; _size && i < _capacity; ++i)
+					if (is_full(_ctrl[i]))
+						_alloc.destroy(_slots + i);
+			}
+
+			void	allocate(size_type capacity)
+			{
+				_ctrl = _alloc_ctrl.allocate(ctrl_bytes(capacity));
+				try
+				{
+					_slots = _alloc.allocate(capacity);
+				}
+				catch (...)
+				{
+					_alloc_ctrl.deallocate(_ctrl, ctrl_bytes(capacity));
+					_ctrl = NULL;
+					throw;
+				}
+				_capacity = capacity;
+				reset_ctrl();
+			}
+
+			void	deallocate()
+			{
+				if (_capacity)
+				{
+					_alloc_ctrl.deallocate(_ctrl, ctrl_bytes(_capacity));
+					_alloc.deallocate(_slots, _capacity);
+				}
+				_ctrl = NULL;
+				_slots = NULL;
+				_capacity = 0;
+				_size = 0;
+			}
+
+			hasher			_hash;
+			key_equal		_eq;
+			allocator_type	_alloc;
+			ctrl_allocator	_alloc_ctrl;
+			sw_ctrl			*_ctrl;
+			value_type		*_slots;
+			size_type		_capacity;
+			size_type		_size;
+			size_type		_growth_left;
+			float			_max_load;
+	};
+}
+
+#endif
@@ -0,0 +1,400 @@
+#ifndef BTREE_MAP_H
+# define BTREE_MAP_H
+
+# include <iostream>
+# include <memory>
+# include <algorithm>
+# include <cstddef>
+# include <limits>
+# include "pair.hpp"
+# include "utilities.hpp"
+# include "_Bp_tree.hpp"
+
+namespace ft
+{
+	/*
+	** Same interface as ft::map, over a B+tree: values sit in arrays inside
+	** cache-line sized leaves chained in key order, so lookups touch a few
+	** nodes and in-order scans run over contiguous memory. Iterators and
+	** references are invalidated by insertions and erasures (see
+	** _Bp_iterator.hpp).
+	*/
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class btree_map {
+	public:
+		class value_compare;
+		typedef Key													key_type;
+		typedef T													mapped_type;
+		typedef pair<const key_type, mapped_type>					value_type;
+		typedef Compare												key_compare;
+		typedef Allocator											allocator_type;
+		typedef typename allocator_type::reference					reference;
+		typedef typename allocator_type::const_reference			const_reference;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef BPTree<key_type, value_type, select_first<value_type>, key_compare, allocator_type>	bp_tree;
+		typedef typename bp_tree::leaf_type							leaf_type;
+		typedef typename bp_tree::iterator							iterator;
+		typedef typename bp_tree::const_iterator					const_iterator;
+		typedef typename bp_tree::reverse_iterator					reverse_iterator;
+		typedef typename bp_tree::const_reverse_iterator			const_reverse_iterator;
+
+		class value_compare
+			: public std::binary_function<value_type, value_type, bool>
+		{
+			friend class btree_map;
+
+		protected:
+			key_compare	comp;
+
+			value_compare(key_compare c) : comp(c) {};
+
+		public:
+			bool operator()(const value_type& lhs, const value_type& rhs) const { return comp(lhs.first, rhs.first); }
+		};
+
+	public:
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit btree_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(comp, alloc), _alloc_pair(alloc), _key_comp(comp) {}
+
+		template <class InputIterator>
+		btree_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(comp, alloc), _alloc_pair(alloc), _key_comp(comp) {
+			
+			_tree.insert(first, last);
+		}
+
+		btree_map(const btree_map& other)
+			: _tree(other._tree), _alloc_pair(other._alloc_pair), _key_comp(other._key_comp) {}
+
+		~btree_map() {}
+
+		btree_map	&operator=(const btree_map &other)
+		{
+			if (this != &other)
+			{
+				_tree = other._tree;
+				_key_comp = other._key_comp;
+				_alloc_pair = other._alloc_pair;
+			}
+			return (*this);
+		}
+
+		allocator_type	get_allocator() const { return _alloc_pair; }
+
+		/****************************************************************************\
+		**								Element access								**
+		\****************************************************************************/
+
+		mapped_type&	at(const key_type& k)
+		{
+			iterator	found = _tree.find(k);
+			if (found != end())
+				return (found->second);
+			throw(std::out_of_range("btree_map::at:  key not found"));
+		}
+
+		const mapped_type&	at(const key_type& k) const
+		{
+			const_iterator	found = _tree.find(k);
+			if (found != end())
+				return (found->second);
+			throw(std::out_of_range("btree_map::at:  key not found"));
+		}
+
+		mapped_type&	operator[] (const key_type& k)
+		{
+			return (try_emplace(k).first->second);
+		}
+
+		/****************************************************************************\
+		**									Iterators								**
+		\****************************************************************************/
+
+		iterator	begin()	{ return (_tree.begin()); }
+
+		const_iterator	begin() const { return (_tree.begin()); }
+
+		iterator	end() { return (_tree.end()); }
+
+		const_iterator	end() const { return (_tree.end()); }
+
+		reverse_iterator rbegin() { return (_tree.rbegin()); }
+		
+		const_reverse_iterator rbegin() const { return (_tree.rbegin()); }
+
+		reverse_iterator rend() { return (_tree.rend()); }
+		
+		const_reverse_iterator rend() const { return (_tree.rend()); }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		bool empty() const { return (_tree.empty()); }
+
+		size_type	size() const { return (_tree.size()); }
+
+		size_type	max_size() const { return (_tree.max_size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	clear() {
+			_tree.clear();
+		}
+
+		pair<iterator, bool>	insert(const value_type& val)
+		{
+			return (_tree.insert(val));
+		}
+
+		iterator	insert(iterator pos, const value_type& val)
+		{
+			return (_tree.insert(pos, val));
+		}
+
+		/*
+		** try_emplace() and insert_or_assign() descend the tree once: on a hit
+		** they hand back the existing slot, and the value is only built when
+		** the key is missing. It is built before any slot moves, so obj may be
+		** an element of the map.
+		*/
+		pair<iterator, bool>	try_emplace(const key_type& k)
+		{
+			leaf_type	*leaf;
+			size_type	pos;
+
+			if (_tree.find_insert_pos(k, leaf, pos))
+				return (ft::make_pair(iterator(leaf, pos), false));
+			return (ft::make_pair(_tree.emplace_at(leaf, pos, k, mapped_type()), true));
+		}
+
+		template <class M>
+		pair<iterator, bool>	try_emplace(const key_type& k, const M& obj)
+		{
+			leaf_type	*leaf;
+			size_type	pos;
+
+			if (_tree.find_insert_pos(k, leaf, pos))
+				return (ft::make_pair(iterator(leaf, pos), false));
+			return (ft::make_pair(_tree.emplace_at(leaf, pos, k, obj), true));
+		}
+
+		template <class M>
+		pair<iterator, bool>	insert_or_assign(const key_type& k, const M& obj)
+		{
+			leaf_type	*leaf;
+			size_type	pos;
+
+			if (_tree.find_insert_pos(k, leaf, pos))
+			{
+				leaf->value(pos).second = obj;
+				return (ft::make_pair(iterator(leaf, pos), false));
+			}
+			return (ft::make_pair(_tree.emplace_at(leaf, pos, k, obj), true));
+		}
+
+		template<class InputIt>
+		void	insert(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			_tree.insert(first, last);
+		}
+
+		iterator	erase(iterator pos)
+		{
+			return (_tree.erase(pos));
+		}
+
+		iterator	erase(iterator first, iterator last)
+		{
+			return (_tree.erase(first, last));
+		}
+
+		size_type	erase(const key_type& key)
+		{
+			return (_tree.erase(key));
+		}
+
+		template <class K>
+		size_type	erase(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0)
+		{
+			return (_tree.erase(key));
+		}
+
+		void	swap(btree_map& other)
+		{
+			_tree.swap(other._tree);
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count( const key_type& key ) const {
+			if (_tree.find(key) != end())
+				return (1);
+			return (0);
+		}
+
+		/*
+		** The template overloads below only exist for transparent comparators:
+		** they look a foreign key up as is, without building a key_type.
+		*/
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key) != end() ? 1 : 0);
+		}
+
+		iterator	find(const key_type& key) {
+			return (_tree.find(key));
+		}
+
+		template <class K>
+		iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.find(key));
+		}
+
+		const_iterator	find(const key_type& key) const {
+			return (_tree.find(key));
+		}
+
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key));
+		}
+
+		ft::pair<iterator,iterator>	equal_range(const key_type& key) {
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<iterator,iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.equal_range(key));
+		}
+
+		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.equal_range(key));
+		}
+
+		iterator		lower_bound(const key_type& key) {
+			return (_tree.lower_bound(key));
+		}
+
+		template <class K>
+		iterator		lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.lower_bound(key));
+		}
+
+		const_iterator	lower_bound(const key_type& key) const {
+			return (_tree.lower_bound(key));
+		}
+
+		template <class K>
+		const_iterator	lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.lower_bound(key));
+		}
+
+		iterator		upper_bound(const key_type& key) {
+			return (_tree.upper_bound(key));
+		}
+
+		template <class K>
+		iterator		upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.upper_bound(key));
+		}
+
+		const_iterator	upper_bound(const key_type& key) const {
+			return (_tree.upper_bound(key));
+		}
+
+		template <class K>
+		const_iterator	upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.upper_bound(key));
+		}
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		key_compare	key_comp() const { return _key_comp; };
+
+		value_compare	value_comp() const { return value_compare(_key_comp); }
+
+	private :
+
+		bp_tree			_tree;
+		allocator_type	_alloc_pair;
+		key_compare		_key_comp;
+	};
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator==(const btree_map<Key, T, Compare, Alloc> &lhs, const btree_map<Key, T, Compare, Alloc> &rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator!=(const btree_map<Key, T, Compare, Alloc> &lhs, const btree_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator<(const btree_map<Key, T, Compare, Alloc> &lhs, const btree_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator<=(const btree_map<Key, T, Compare, Alloc> &lhs, const btree_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator>(const btree_map<Key, T, Compare, Alloc> &lhs, const btree_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator>=(const btree_map<Key, T, Compare, Alloc> &lhs, const btree_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	void	swap(btree_map<Key, T, Compare, Alloc> &lhs, btree_map<Key, T, Compare, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
\ No newline at end of file
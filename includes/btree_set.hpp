@@ -0,0 +1,316 @@
+#ifndef BTREE_SET_H
+# define BTREE_SET_H
+
+# include <iostream>
+# include <memory>
+# include <algorithm>
+# include <cstddef>
+# include <limits>
+# include "utilities.hpp"
+# include "_Bp_tree.hpp"
+
+namespace ft
+{
+	/*
+	** Same interface as ft::set, over a B+tree: values sit in arrays inside
+	** cache-line sized leaves chained in key order, so lookups touch a few
+	** nodes and in-order scans run over contiguous memory. Iterators and
+	** references are invalidated by insertions and erasures (see
+	** _Bp_iterator.hpp).
+	*/
+	template <class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key>>
+	class btree_set {
+	public:
+		typedef Key													key_type;
+		typedef Key													value_type;
+		typedef Compare												key_compare;
+		typedef Compare												value_compare;
+		typedef Allocator											allocator_type;
+		typedef value_type&											reference;
+		typedef const value_type&									const_reference;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef BPTree<key_type, value_type, identity<value_type>, key_compare, allocator_type>	bp_tree;
+		typedef typename bp_tree::const_iterator					iterator;
+		typedef typename bp_tree::const_iterator					const_iterator;
+		typedef ft::reverse_iterator<iterator>						reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>				const_reverse_iterator;
+
+	public:
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit btree_set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(comp, alloc), _alloc(alloc), _key_comp(comp) {}
+
+		template <class InputIterator>
+		btree_set(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(comp, alloc), _alloc(alloc), _key_comp(comp) {
+			
+			_tree.insert(first, last);
+		}
+
+		btree_set(const btree_set& other)
+			: _tree(other._tree), _alloc(other._alloc), _key_comp(other._key_comp) {}
+
+		~btree_set() {}
+
+		btree_set	&operator=(const btree_set &other)
+		{
+			if (this != &other)
+			{
+				_tree = other._tree;
+				_key_comp = other._key_comp;
+				_alloc = other._alloc;
+			}
+			return (*this);
+		}
+
+		allocator_type	get_allocator() const { return _alloc; }
+
+		/****************************************************************************\
+		**									Iterators								**
+		\****************************************************************************/
+
+		iterator	begin()	{ return (_tree.begin()); }
+
+		const_iterator	begin() const { return (_tree.begin()); }
+
+		iterator	end() { return (_tree.end()); }
+
+		const_iterator	end() const { return (_tree.end()); }
+
+		reverse_iterator rbegin() { return (_tree.rbegin()); }
+		
+		const_reverse_iterator rbegin() const { return (_tree.rbegin()); }
+
+		reverse_iterator rend() { return (_tree.rend()); }
+		
+		const_reverse_iterator rend() const { return (_tree.rend()); }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		bool empty() const { return (_tree.empty()); }
+
+		size_type	size() const { return (_tree.size()); }
+
+		size_type	max_size() const { return (_tree.max_size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	clear() {
+			_tree.clear();
+		}
+
+		pair<iterator, bool>	insert(const value_type& val)
+		{
+			return (_tree.insert(val));
+		}
+
+		iterator	insert(iterator pos, const value_type& val)
+		{
+			return (_tree.insert(pos, val));
+		}
+
+		template<class InputIt>
+		void	insert(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			_tree.insert(first, last);
+		}
+
+		iterator	erase(iterator pos)
+		{
+			return (_tree.erase(pos));
+		}
+
+		iterator	erase(iterator first, iterator last)
+		{
+			return (_tree.erase(first, last));
+		}
+
+		size_type	erase(const key_type& key)
+		{
+			return (_tree.erase(key));
+		}
+
+		template <class K>
+		size_type	erase(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0)
+		{
+			return (_tree.erase(key));
+		}
+
+		void	swap(btree_set& other)
+		{
+			_tree.swap(other._tree);
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count( const key_type& key ) const {
+			if (_tree.find(key) != end())
+				return (1);
+			return (0);
+		}
+
+		/*
+		** The template overloads below only exist for transparent comparators:
+		** they look a foreign key up as is, without building a key_type.
+		*/
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key) != end() ? 1 : 0);
+		}
+
+		iterator	find(const key_type& key) {
+			return (_tree.find(key));
+		}
+
+		template <class K>
+		iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.find(key));
+		}
+
+		const_iterator	find (const key_type& key) const {
+			return (_tree.find(key));
+		}
+
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key));
+		}
+
+		ft::pair<iterator,iterator>	equal_range(const key_type& key) {
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<iterator,iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.equal_range(key));
+		}
+
+		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.equal_range(key));
+		}
+
+		iterator		lower_bound(const key_type& key) {
+			return (_tree.lower_bound(key));
+		}
+
+		template <class K>
+		iterator		lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.lower_bound(key));
+		}
+
+		const_iterator	lower_bound(const key_type& key) const {
+			return (_tree.lower_bound(key));
+		}
+
+		template <class K>
+		const_iterator	lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.lower_bound(key));
+		}
+
+		iterator		upper_bound(const key_type& key) {
+			return (_tree.upper_bound(key));
+		}
+
+		template <class K>
+		iterator		upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.upper_bound(key));
+		}
+
+		const_iterator	upper_bound(const key_type& key) const {
+			return (_tree.upper_bound(key));
+		}
+
+		template <class K>
+		const_iterator	upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.upper_bound(key));
+		}
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		key_compare	key_comp() const { return _key_comp; };
+
+		value_compare	value_comp() const { return value_compare(_key_comp); }
+
+	private :
+		bp_tree			_tree;
+		allocator_type	_alloc;
+		key_compare		_key_comp;
+	};
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator==(const btree_set<Key, Compare, Alloc> &lhs, const btree_set<Key, Compare, Alloc> &rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator!=(const btree_set<Key, Compare, Alloc> &lhs, const btree_set<Key, Compare, Alloc> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator<(const btree_set<Key, Compare, Alloc> &lhs, const btree_set<Key, Compare, Alloc> &rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator<=(const btree_set<Key, Compare, Alloc> &lhs, const btree_set<Key, Compare, Alloc> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator>(const btree_set<Key, Compare, Alloc> &lhs, const btree_set<Key, Compare, Alloc> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator>=(const btree_set<Key, Compare, Alloc> &lhs, const btree_set<Key, Compare, Alloc> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	void	swap(btree_set<Key, Compare, Alloc> &lhs, btree_set<Key, Compare, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,273 @@
+#ifndef CONCURRENT_SKIPLIST_MAP_H
+# define CONCURRENT_SKIPLIST_MAP_H
+
+# include <iostream>
+# include <memory>
+# include <algorithm>
+# include <cstddef>
+# include <limits>
+# include "utilities.hpp"
+# include "_Sl_list.hpp"
+
+namespace ft
+{
+	/*
+	** The lookup and bound interface of ft::map over a lock-free skiplist:
+	** any number of threads may insert, erase and look up at once without
+	** ever waiting on a lock (see _Sl_list.hpp). Iteration is forward only
+	** and weakly consistent: an iterator is never invalidated, but it may
+	** or may not see the changes made ahead of it while it walks (see
+	** _Sl_iterator.hpp). size() is exact only while no update is running.
+	**
+	** Elements are read-only once inserted, as a thread may be reading one
+	** while another writes it: there is no operator[], and iterators are
+	** all const. To change a value, erase the key and insert it again.
+	**
+	** Copying, assigning and destroying a map must not race updates to it.
+	*/
+	template <class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class concurrent_skiplist_map {
+	public:
+		class value_compare;
+		typedef Key													key_type;
+		typedef T													mapped_type;
+		typedef pair<const key_type, mapped_type>					value_type;
+		typedef Compare												key_compare;
+		typedef Allocator											allocator_type;
+		typedef typename allocator_type::reference					reference;
+		typedef typename allocator_type::const_reference			const_reference;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef SkipList<key_type, value_type, select_first<value_type>, key_compare, allocator_type>	skip_list;
+		typedef typename skip_list::const_iterator					iterator;
+		typedef typename skip_list::const_iterator					const_iterator;
+
+		class value_compare
+			: public std::binary_function<value_type, value_type, bool>
+		{
+			friend class concurrent_skiplist_map;
+
+		protected:
+			key_compare	comp;
+
+			value_compare(key_compare c) : comp(c) {};
+
+		public:
+			bool operator()(const value_type& lhs, const value_type& rhs) const { return comp(lhs.first, rhs.first); }
+		};
+
+	public:
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit concurrent_skiplist_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _list(comp, alloc), _alloc(alloc), _key_comp(comp) {}
+
+		template <class InputIterator>
+		concurrent_skiplist_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _list(comp, alloc), _alloc(alloc), _key_comp(comp) {
+
+			insert(first, last);
+		}
+
+		concurrent_skiplist_map(const concurrent_skiplist_map& other)
+			: _list(other._key_comp, other._alloc), _alloc(other._alloc), _key_comp(other._key_comp) {
+
+			insert(other.begin(), other.end());
+		}
+
+		~concurrent_skiplist_map() {}
+
+		concurrent_skiplist_map	&operator=(const concurrent_skiplist_map &other)
+		{
+			if (this != &other)
+			{
+				clear();
+				_key_comp = other._key_comp;
+				_list.key_comp(other._key_comp);
+				insert(other.begin(), other.end());
+			}
+			return (*this);
+		}
+
+		allocator_type	get_allocator() const { return _alloc; }
+
+		/****************************************************************************\
+		**									Iterators								**
+		\****************************************************************************/
+
+		const_iterator	begin() const { return (_list.begin()); }
+
+		const_iterator	end() const { return (_list.end()); }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		bool empty() const { return (_list.empty()); }
+
+		size_type	size() const { return (_list.size()); }
+
+		size_type	max_size() const { return (_list.max_size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	clear() {
+			_list.clear();
+		}
+
+		pair<iterator, bool>	insert(const value_type& val)
+		{
+			return (_list.insert(val));
+		}
+
+		/*
+		** The hint is ignored: a skiplist search has no use for it.
+		*/
+		iterator	insert(iterator, const value_type& val)
+		{
+			return (_list.insert(val).first);
+		}
+
+		template<class InputIt>
+		void	insert(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			for (; first != last; ++first)
+				_list.insert(*first);
+		}
+
+		/*
+		** Erases the element pos stands on, if no other thread did first.
+		*/
+		void	erase(iterator pos)
+		{
+			_list.erase(pos->first);
+		}
+
+		size_type	erase(const key_type& key)
+		{
+			return (_list.erase(key));
+		}
+
+		template <class K>
+		size_type	erase(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0)
+		{
+			return (_list.erase(key));
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count( const key_type& key ) const {
+			return (_list.contains(key) ? 1 : 0);
+		}
+
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_list.contains(key) ? 1 : 0);
+		}
+
+		const_iterator	find(const key_type& key) const {
+			return (_list.find(key));
+		}
+
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_list.find(key));
+		}
+
+		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
+			return (_list.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_list.equal_range(key));
+		}
+
+		const_iterator	lower_bound(const key_type& key) const {
+			return (_list.lower_bound(key));
+		}
+
+		template <class K>
+		const_iterator	lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_list.lower_bound(key));
+		}
+
+		const_iterator	upper_bound(const key_type& key) const {
+			return (_list.upper_bound(key));
+		}
+
+		template <class K>
+		const_iterator	upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_list.upper_bound(key));
+		}
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		key_compare	key_comp() const { return _key_comp; };
+
+		value_compare	value_comp() const { return value_compare(_key_comp); }
+
+	private :
+		skip_list		_list;
+		allocator_type	_alloc;
+		key_compare		_key_comp;
+	};
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator==(const concurrent_skiplist_map<Key, T, Compare, Alloc> &lhs, const concurrent_skiplist_map<Key, T, Compare, Alloc> &rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator!=(const concurrent_skiplist_map<Key, T, Compare, Alloc> &lhs, const concurrent_skiplist_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator<(const concurrent_skiplist_map<Key, T, Compare, Alloc> &lhs, const concurrent_skiplist_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator<=(const concurrent_skiplist_map<Key, T, Compare, Alloc> &lhs, const concurrent_skiplist_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator>(const concurrent_skiplist_map<Key, T, Compare, Alloc> &lhs, const concurrent_skiplist_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator>=(const concurrent_skiplist_map<Key, T, Compare, Alloc> &lhs, const concurrent_skiplist_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+}
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef FROZEN_SET_H
+# define FROZEN_SET_H
+
+# include <iostream>
+# include <memory>
+# include <algorithm>
+# include <cstddef>
+# include <limits>
+# include "utilities.hpp"
+# include "set.hpp"
+# include "_Ez_tree.hpp"
+
+namespace ft
+{
+	/*
+	** Read-only copy of an ft::set, laid out like frozen_map's keys: one
+	** contiguous array in Eytzinger order, searched without branching
+	** (see _Ez_tree.hpp). There is nothing to insert or erase; to change
+	** the contents, edit a set and freeze it again.
+	*/
+	template <class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+	class frozen_set {
+	public:
+		typedef Key													key_type;
+		typedef Key													value_type;
+		typedef Compare												key_compare;
+		typedef Compare												value_compare;
+		typedef Allocator											allocator_type;
+		typedef typename allocator_type::reference					reference;
+		typedef typename allocator_type::const_reference			const_reference;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef EZTree<key_type, value_type, identity<value_type>, key_compare, allocator_type>	ez_tree;
+		typedef typename ez_tree::const_iterator					iterator;
+		typedef typename ez_tree::const_iterator					const_iterator;
+		typedef typename ez_tree::const_reverse_iterator			reverse_iterator;
+		typedef typename ez_tree::const_reverse_iterator			const_reverse_iterator;
+
+	public:
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit frozen_set(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(comp, alloc), _alloc(alloc), _key_comp(comp) {}
+
+		/*
+		** Copies the elements of source, whatever its allocator and
+		** augmentation; source is left as it is.
+		*/
+		template <class SetAlloc, class Augment>
+		explicit frozen_set(const set<Key, Compare, SetAlloc, Augment>& source, const allocator_type& alloc = allocator_type())
+			: _tree(source.key_comp(), alloc), _alloc(alloc), _key_comp(source.key_comp()) {
+
+			_tree.build(source.begin(), source.size());
+		}
+
+		frozen_set(const frozen_set& other)
+			: _tree(other._tree), _alloc(other._alloc), _key_comp(other._key_comp) {}
+
+		~frozen_set() {}
+
+		frozen_set	&operator=(const frozen_set &other)
+		{
+			if (this != &other)
+			{
+				_tree = other._tree;
+				_key_comp = other._key_comp;
+				_alloc = other._alloc;
+			}
+			return (*this);
+		}
+
+		allocator_type	get_allocator() const { return _alloc; }
+
+		/****************************************************************************\
+		**									Iterators								**
+		\****************************************************************************/
+
+		const_iterator	begin() const { return (_tree.begin()); }
+
+		const_iterator	end() const { return (_tree.end()); }
+
+		const_reverse_iterator rbegin() const { return (_tree.rbegin()); }
+
+		const_reverse_iterator rend() const { return (_tree.rend()); }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		bool empty() const { return (_tree.empty()); }
+
+		size_type	size() const { return (_tree.size()); }
+
+		size_type	max_size() const { return (_tree.max_size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	swap(frozen_set& other)
+		{
+			_tree.swap(other._tree);
+			ft::swap_elements(_alloc, other._alloc);
+			ft::swap_elements(_key_comp, other._key_comp);
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count( const key_type& key ) const {
+			if (_tree.find(key) != end())
+				return (1);
+			return (0);
+		}
+
+		/*
+		** The template overloads below only exist for transparent comparators:
+		** they look a foreign key up as is, without building a key_type.
+		*/
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key) != end() ? 1 : 0);
+		}
+
+		const_iterator	find(const key_type& key) const {
+			return (_tree.find(key));
+		}
+
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key));
+		}
+
+		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.equal_range(key));
+		}
+
+		const_iterator	lower_bound(const key_type& key) const {
+			return (_tree.lower_bound(key));
+		}
+
+		template <class K>
+		const_iterator	lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.lower_bound(key));
+		}
+
+		const_iterator	upper_bound(const key_type& key) const {
+			return (_tree.upper_bound(key));
+		}
+
+		template <class K>
+		const_iterator	upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.upper_bound(key));
+		}
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		key_compare	key_comp() const { return _key_comp; };
+
+		value_compare	value_comp() const { return _key_comp; }
+
+	private :
+
+		ez_tree			_tree;
+		allocator_type	_alloc;
+		key_compare		_key_comp;
+	};
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator==(const frozen_set<Key, Compare, Alloc> &lhs, const frozen_set<Key, Compare, Alloc> &rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator!=(const frozen_set<Key, Compare, Alloc> &lhs, const frozen_set<Key, Compare, Alloc> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator<(const frozen_set<Key, Compare, Alloc> &lhs, const frozen_set<Key, Compare, Alloc> &rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator<=(const frozen_set<Key, Compare, Alloc> &lhs, const frozen_set<Key, Compare, Alloc> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator>(const frozen_set<Key, Compare, Alloc> &lhs, const frozen_set<Key, Compare, Alloc> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class Compare, class Alloc>
+	bool	operator>=(const frozen_set<Key, Compare, Alloc> &lhs, const frozen_set<Key, Compare, Alloc> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class Compare, class Alloc>
+	void	swap(frozen_set<Key, Compare, Alloc> &lhs, frozen_set<Key, Compare, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -0,0 +1,375 @@
+#ifndef INTERVAL_MAP_H
+# define INTERVAL_MAP_H
+
+# include <iostream>
+# include <memory>
+# include <algorithm>
+# include <cstddef>
+# include <limits>
+# include "pair.hpp"
+# include "utilities.hpp"
+# include "_Rb_tree.hpp"
+
+namespace ft
+{
+	/*
+	** Keeps the largest end point of each subtree of intervals; nil holds
+	** nothing, readers test the sentinel flag first. Compare has to be
+	** stateless, as update() builds its own.
+	*/
+	template <class Point, class Compare>
+	struct rb_max_end
+	{
+		static const bool	enabled = true;
+
+		struct node_data
+		{
+			Point	max_end;
+		};
+
+		template <class N>
+		static void	update(N *node)
+		{
+			Compare		comp;
+			const Point	*max_end = &node->data.first.second;
+
+			if (!node->left->sentinel && comp(*max_end, node->left->max_end))
+				max_end = &node->left->max_end;
+			if (!node->right->sentinel && comp(*max_end, node->right->max_end))
+				max_end = &node->right->max_end;
+			node->max_end = *max_end;
+		}
+
+		template <class N>
+		static void	reset(N *) {}
+	};
+
+	/*
+	** Half-open intervals [start, end) mapped to values, kept in a red-black
+	** tree ordered by start, then end, and augmented with the largest end
+	** point below each node (rb_max_end). A query walks down the tree and
+	** skips any subtree whose largest end is not past the query's start, or
+	** whose starts are all past its end, so reporting the k intervals that
+	** match takes O(min(n, (k + 1) log n)), and finding one of them, or
+	** that there is none, O(log n).
+	**
+	** The key is the pair (start, end): equal intervals are one key. Point
+	** must be default constructible and Compare stateless.
+	*/
+	template <class Point, class T, class Compare = std::less<Point>,
+		class Allocator = std::allocator<ft::pair<const ft::pair<Point, Point>, T> > >
+	class interval_map {
+	public:
+		class key_compare;
+		typedef Point												point_type;
+		typedef ft::pair<Point, Point>								key_type;
+		typedef T													mapped_type;
+		typedef pair<const key_type, mapped_type>					value_type;
+		typedef Compare												point_compare;
+		typedef Allocator											allocator_type;
+		typedef typename allocator_type::reference					reference;
+		typedef typename allocator_type::const_reference			const_reference;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef rb_max_end<point_type, point_compare>				augment_type;
+		typedef	Node<value_type, augment_type>						tree_node;
+		typedef RBTree<key_type, value_type, select_first<value_type>, key_compare, allocator_type, augment_type>	Rb_tree;
+		typedef typename Rb_tree::iterator							iterator;
+		typedef typename Rb_tree::const_iterator					const_iterator;
+		typedef typename Rb_tree::reverse_iterator					reverse_iterator;
+		typedef typename Rb_tree::const_reverse_iterator			const_reverse_iterator;
+
+		/*
+		** By start, then by end.
+		*/
+		class key_compare
+			: public std::binary_function<key_type, key_type, bool>
+		{
+		protected:
+			point_compare	comp;
+
+		public:
+			key_compare(point_compare c = point_compare()) : comp(c) {};
+
+			bool operator()(const key_type& lhs, const key_type& rhs) const
+			{
+				if (comp(lhs.first, rhs.first))
+					return (true);
+				return (!comp(rhs.first, lhs.first) && comp(lhs.second, rhs.second));
+			}
+		};
+
+	public:
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit interval_map(const point_compare& comp = point_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(key_compare(comp), alloc), _alloc_pair(alloc), _comp(comp) {}
+
+		template <class InputIterator>
+		interval_map(InputIterator first, InputIterator last, const point_compare& comp = point_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(key_compare(comp), alloc), _alloc_pair(alloc), _comp(comp) {
+
+			insert(first, last);
+		}
+
+		interval_map(const interval_map& other)
+			: _tree(other._tree), _alloc_pair(other._alloc_pair), _comp(other._comp) {}
+
+		~interval_map() {}
+
+		interval_map	&operator=(const interval_map &other)
+		{
+			if (this != &other)
+			{
+				_tree = other._tree;
+				_comp = other._comp;
+				_alloc_pair = other._alloc_pair;
+			}
+			return (*this);
+		}
+
+		allocator_type	get_allocator() const { return _alloc_pair; }
+
+		/****************************************************************************\
+		**									Iterators								**
+		\****************************************************************************/
+
+		iterator	begin()	{ return (_tree.begin()); }
+
+		const_iterator	begin() const { return (_tree.begin()); }
+
+		iterator	end() { return (_tree.end()); }
+
+		const_iterator	end() const { return (_tree.end()); }
+
+		reverse_iterator rbegin() { return (_tree.rbegin()); }
+
+		const_reverse_iterator rbegin() const { return (_tree.rbegin()); }
+
+		reverse_iterator rend() { return (_tree.rend()); }
+
+		const_reverse_iterator rend() const { return (_tree.rend()); }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		bool empty() const { return (_tree.empty()); }
+
+		size_type	size() const { return (_tree.size()); }
+
+		size_type	max_size() const { return (_tree.max_size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	clear() {
+			_tree.clear();
+		}
+
+		void	reserve(size_type n) {
+			_tree.reserve(n);
+		}
+
+		/*
+		** An interval has to hold at least one point: one whose end is not
+		** past its start is turned down, with (end(), false), and skipped by
+		** the range insert.
+		*/
+		pair<iterator, bool>	insert(const value_type& val)
+		{
+			if (!_comp(val.first.first, val.first.second))
+				return (ft::make_pair(end(), false));
+			return (_tree.insert(val));
+		}
+
+		pair<iterator, bool>	insert(const point_type& start, const point_type& end, const mapped_type& obj)
+		{
+			if (!_comp(start, end))
+				return (ft::make_pair(this->end(), false));
+			return (_tree.insert(value_type(key_type(start, end), obj)));
+		}
+
+		template<class InputIt>
+		void	insert(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			for (; first != last; ++first)
+				if (_comp(first->first.first, first->first.second))
+					_tree.insert(_tree.end(), *first);
+		}
+
+		iterator	erase(iterator pos)
+		{
+			return (_tree.erase(pos));
+		}
+
+		iterator	erase(iterator first, iterator last)
+		{
+			return (_tree.erase(first, last));
+		}
+
+		size_type	erase(const key_type& key)
+		{
+			return (_tree.erase(key));
+		}
+
+		void	swap(interval_map& other)
+		{
+			_tree.swap(other._tree);
+			ft::swap_elements(_alloc_pair, other._alloc_pair);
+			ft::swap_elements(_comp, other._comp);
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count(const key_type& key) const {
+			return (_tree.search(_tree.root(), key) ? 1 : 0);
+		}
+
+		iterator	find(const key_type& key) {
+			return (_tree.find(key));
+		}
+
+		const_iterator	find(const key_type& key) const {
+			return (_tree.find(key));
+		}
+
+		/****************************************************************************\
+		**								Interval queries							**
+		\****************************************************************************/
+
+		/*
+		** overlapping() writes, in order, an iterator to each interval that
+		** shares a point with [lo, hi), none if the range is empty; stabbing()
+		** one to each interval that contains x. Both return the output
+		** iterator past the last one.
+		*/
+		template <class OutputIt>
+		OutputIt	overlapping(const point_type& lo, const point_type& hi, OutputIt out) {
+			if (!_comp(lo, hi))
+				return (out);
+			return (collect<iterator>(_tree.root(), lo, hi, false, out));
+		}
+
+		template <class OutputIt>
+		OutputIt	overlapping(const point_type& lo, const point_type& hi, OutputIt out) const {
+			if (!_comp(lo, hi))
+				return (out);
+			return (collect<const_iterator>(_tree.root(), lo, hi, false, out));
+		}
+
+		template <class OutputIt>
+		OutputIt	stabbing(const point_type& x, OutputIt out) {
+			return (collect<iterator>(_tree.root(), x, x, true, out));
+		}
+
+		template <class OutputIt>
+		OutputIt	stabbing(const point_type& x, OutputIt out) const {
+			return (collect<const_iterator>(_tree.root(), x, x, true, out));
+		}
+
+		/*
+		** Some interval overlapping [lo, hi), end() if there is none.
+		*/
+		iterator	find_overlap(const point_type& lo, const point_type& hi) {
+			if (!_comp(lo, hi))
+				return (end());
+			return (iterator(any_overlap(lo, hi)));
+		}
+
+		const_iterator	find_overlap(const point_type& lo, const point_type& hi) const {
+			if (!_comp(lo, hi))
+				return (end());
+			return (iterator(any_overlap(lo, hi)));
+		}
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		key_compare	key_comp() const { return key_compare(_comp); };
+
+		point_compare	point_comp() const { return _comp; }
+
+	private :
+		/*
+		** With stab, lo and hi are both the point x and an interval matches
+		** when start <= x < end; otherwise when start < hi and lo < end. Every
+		** subtree left of a node may match as long as its largest end is
+		** past lo; the right one only if the node's start still is in range.
+		** Recurses on the left, loops on the right.
+		*/
+		template <class It, class OutputIt>
+		OutputIt	collect(tree_node *node, const point_type& lo, const point_type& hi, bool stab, OutputIt out) const
+		{
+			while (!node->sentinel && _comp(lo, node->max_end))
+			{
+				out = collect<It>(node->left, lo, hi, stab, out);
+
+				const point_type	&start = node->data.first.first;
+
+				if (stab ? _comp(hi, start) : !_comp(start, hi))
+					break;
+				if (_comp(lo, node->data.first.second))
+					*out++ = It(iterator(node));
+				node = node->right;
+			}
+			return (out);
+		}
+
+		/*
+		** When the left subtree reaches past lo but holds no match, all its
+		** intervals start at or after hi, and so do those on the right.
+		*/
+		tree_node	*any_overlap(const point_type& lo, const point_type& hi) const
+		{
+			tree_node	*node = _tree.root();
+
+			while (!node->sentinel)
+			{
+				if (_comp(node->data.first.first, hi) && _comp(lo, node->data.first.second))
+					return (node);
+				if (!node->left->sentinel && _comp(lo, node->left->max_end))
+					node = node->left;
+				else
+					node = node->right;
+			}
+			return (node);
+		}
+
+		Rb_tree			_tree;
+		allocator_type	_alloc_pair;
+		point_compare	_comp;
+	};
+
+	template <class Point, class T, class Compare, class Alloc>
+	bool	operator==(const interval_map<Point, T, Compare, Alloc> &lhs, const interval_map<Point, T, Compare, Alloc> &rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Point, class T, class Compare, class Alloc>
+	bool	operator!=(const interval_map<Point, T, Compare, Alloc> &lhs, const interval_map<Point, T, Compare, Alloc> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Point, class T, class Compare, class Alloc>
+	void	swap(interval_map<Point, T, Compare, Alloc> &lhs, interval_map<Point, T, Compare, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -14,7 +14,13 @@
 
 namespace ft
 {
-	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	/*
+	** Augment selects an optional per-node augmentation of the underlying
+	** tree: ft::rb_subtree_size enables nth(), rank() and count_range(),
+	** ft::rb_aggregate<Monoid> enables aggregate().
+	*/
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> >,
+		class Augment = rb_no_augment>
 	class map {
 	public:
 		class value_compare;
@@ -30,12 +36,14 @@ namespace ft
 		typedef typename allocator_type::size_type					size_type;
 		typedef typename allocator_type::difference_type			difference_type;
 
-		typedef	Node<value_type>									tree_node;
-		typedef RBTree<value_type, value_compare, allocator_type>	Rb_tree;
+		typedef	Node<value_type, Augment>							tree_node;
+		typedef RBTree<key_type, value_type, select_first<value_type>, key_compare, allocator_type, Augment>	Rb_tree;
 		typedef typename Rb_tree::iterator							iterator;
 		typedef typename Rb_tree::const_iterator					const_iterator;
 		typedef typename Rb_tree::reverse_iterator					reverse_iterator;
 		typedef typename Rb_tree::const_reverse_iterator			const_reverse_iterator;
+		typedef typename Rb_tree::node_handle						node_type;
+		typedef RBInsertReturn<iterator, node_type>					insert_return_type;
 
 		class value_compare
 			: public std::binary_function<value_type, value_type, bool>
@@ -90,7 +98,7 @@ namespace ft
 
 		mapped_type&	at(const key_type& k)
 		{
-			tree_node	*found = _tree.search(_tree.root(), ft::make_pair(k, mapped_type()));
+			tree_node	*found = _tree.search(k);
 			if (found)
 				return (found->data.second);
 			throw(std::out_of_range("map::at:  key not found"));
@@ -98,12 +106,15 @@ namespace ft
 
 		const mapped_type&	at(const key_type& k) const
 		{
-			return (const_cast<mapped_type>(at((k))));
+			tree_node	*found = _tree.search(k);
+			if (found)
+				return (found->data.second);
+			throw(std::out_of_range("map::at:  key not found"));
 		}
 
 		mapped_type&	operator[] (const key_type& k)
 		{
-			return ((*(insert(ft::make_pair(k, mapped_type())).first)).second);
+			return (try_emplace(k).first->second);
 		}
 
 		/****************************************************************************\
@@ -141,7 +152,21 @@ namespace ft
 		\****************************************************************************/
 
 		void	clear() {
-			_tree.clear(_tree.root());
+			_tree.clear();
+		}
+
+		void	reserve(size_type n) {
+			_tree.reserve(n);
+		}
+
+		/*
+		** clear() then insert(first, last), reusing the nodes cleared.
+		*/
+		template<class InputIt>
+		void	assign(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			_tree.assign(first, last);
 		}
 
 		pair<iterator, bool>	insert(const value_type& val)
@@ -154,6 +179,50 @@ namespace ft
 			return (_tree.insert(pos, val));
 		}
 
+		/*
+		** try_emplace() and insert_or_assign() descend the tree once: on a hit
+		** they hand back the existing slot, and the value is only built, right
+		** inside the new node, when the key is missing.
+		*/
+		pair<iterator, bool>	try_emplace(const key_type& k)
+		{
+			tree_node	*parent;
+			bool		left;
+			tree_node	*found = _tree.find_insert_pos(k, parent, left);
+
+			if (found)
+				return (ft::make_pair(iterator(found), false));
+			return (ft::make_pair(_tree.emplace_at(parent, left, k, mapped_type()), true));
+		}
+
+		template <class M>
+		pair<iterator, bool>	try_emplace(const key_type& k, const M& obj)
+		{
+			tree_node	*parent;
+			bool		left;
+			tree_node	*found = _tree.find_insert_pos(k, parent, left);
+
+			if (found)
+				return (ft::make_pair(iterator(found), false));
+			return (ft::make_pair(_tree.emplace_at(parent, left, k, obj), true));
+		}
+
+		template <class M>
+		pair<iterator, bool>	insert_or_assign(const key_type& k, const M& obj)
+		{
+			tree_node	*parent;
+			bool		left;
+			tree_node	*found = _tree.find_insert_pos(k, parent, left);
+
+			if (found)
+			{
+				found->data.second = obj;
+				_tree.refresh(iterator(found));
+				return (ft::make_pair(iterator(found), false));
+			}
+			return (ft::make_pair(_tree.emplace_at(parent, left, k, obj), true));
+		}
+
 		template<class InputIt>
 		void	insert(InputIt first, InputIt last,
 			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
@@ -161,19 +230,77 @@ namespace ft
 			_tree.insert(first, last);
 		}
 
-		void	erase(iterator pos)
+		iterator	erase(iterator pos)
 		{
-			_tree.erase(pos.base());
+			return (_tree.erase(pos));
 		}
 
-		void	erase(iterator first, iterator last)
+		iterator	erase(iterator first, iterator last)
 		{
-			_tree.erase(first, last);
+			return (_tree.erase(first, last));
 		}
 
 		size_type	erase(const key_type& key)
 		{
-			return (_tree.erase(ft::make_pair(key, mapped_type())));
+			return (_tree.erase(key));
+		}
+
+		template <class K>
+		size_type	erase(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0)
+		{
+			return (_tree.erase(key));
+		}
+
+		/*
+		** Moves elements between maps of the same type by relinking their
+		** nodes: nothing is copied or allocated (see RBTree::extract()).
+		** Before C++11, insert() only takes a handle held in a variable.
+		*/
+		node_type	extract(const_iterator pos)
+		{
+			return (_tree.extract(pos));
+		}
+
+		node_type	extract(const key_type& key)
+		{
+			return (_tree.extract(key));
+		}
+
+		insert_return_type	insert(node_type& handle)
+		{
+			ft::pair<iterator, bool>	res = _tree.insert(handle);
+			insert_return_type			ret(res.first, res.second);
+
+			if (!res.second)
+				ret.node.swap(handle);
+			return (ret);
+		}
+
+		iterator	insert(const_iterator hint, node_type& handle)
+		{
+			return (_tree.insert(hint, handle));
+		}
+
+# if __cplusplus >= 201103L
+		insert_return_type	insert(node_type&& handle)
+		{
+			return (insert(handle));
+		}
+
+		iterator	insert(const_iterator hint, node_type&& handle)
+		{
+			return (insert(hint, handle));
+		}
+# endif
+
+		/*
+		** Moves in every element of source whose key is missing here; the
+		** others stay in source.
+		*/
+		void	merge(map& source)
+		{
+			_tree.merge(source._tree);
 		}
 
 		void	swap(map& other)
@@ -186,77 +313,209 @@ namespace ft
 		\****************************************************************************/
 
 		size_type	count( const key_type& key ) const {
-			tree_node	*found(_tree.search(_tree.root(), ft::make_pair(key, mapped_type())));
+			tree_node	*found(_tree.search(key));
 
 			if (found)
 				return (1);
 			return (0);
 		}
 
+		/*
+		** The template overloads below only exist for transparent comparators:
+		** they look a foreign key up as is, without building a key_type.
+		*/
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.search(key) ? 1 : 0);
+		}
+
 		iterator	find(const key_type& key) {
-			return (_tree.find(ft::make_pair(key, mapped_type())));
+			return (_tree.find(key));
+		}
+
+		template <class K>
+		iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.find(key));
 		}
 
 		const_iterator	find(const key_type& key) const {
-			return (_tree.find(ft::make_pair(key, mapped_type())));
+			return (_tree.find(key));
 		}
 
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key));
+		}
+
+		/*
+		** Looks key up from hint rather than from the root: O(log d) for a
+		** key d elements away from hint. Any hint is correct, end() included.
+		*/
+		iterator	find(const_iterator hint, const key_type& key) {
+			return (_tree.find(hint, key));
+		}
+
+		template <class K>
+		iterator	find(const_iterator hint, const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.find(hint, key));
+		}
+
+		const_iterator	find(const_iterator hint, const key_type& key) const {
+			return (_tree.find(hint, key));
+		}
+
+		template <class K>
+		const_iterator	find(const_iterator hint, const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(hint, key));
+		}
+
+		/*
+		** Finger mode, off by default: every lookup (find, count, at) starts
+		** from where the previous one ended, which makes runs of nearby keys
+		** cheap (see RBTree::finger_search()). Lookups then update the map,
+		** so a map in finger mode must not be read from several threads at once.
+		*/
+		void	finger_search(bool on) { _tree.finger_search(on); }
+
+		bool	finger_search() const { return (_tree.finger_search()); }
+
 		ft::pair<iterator,iterator>	equal_range(const key_type& key) {
-			return (ft::make_pair(lower_bound(key), upper_bound(key)));
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<iterator,iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.equal_range(key));
 		}
 
 		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
-			return (ft::make_pair(lower_bound(key), upper_bound(key)));
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.equal_range(key));
 		}
 
 		iterator		lower_bound(const key_type& key) {
-			iterator	it(begin()), ite(end());
+			return (_tree.lower_bound(key));
+		}
 
-			while (it != ite)
-			{
-				if (!_key_comp(it->first, key))
-					break ;
-				it++;
-			}
-			return (it);
+		template <class K>
+		iterator		lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.lower_bound(key));
 		}
 
 		const_iterator	lower_bound(const key_type& key) const {
-			const_iterator	it(begin()), ite(end());
+			return (_tree.lower_bound(key));
+		}
 
-			while (it != ite)
-			{
-				if (!_key_comp(it->first, key))
-					break ;
-				it++;
-			}
-			return (it);
+		template <class K>
+		const_iterator	lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.lower_bound(key));
 		}
 
 		iterator		upper_bound(const key_type& key) {
-			iterator	it(begin()), ite(end());
+			return (_tree.upper_bound(key));
+		}
 
-			while (it != ite)
-			{
-				if (_key_comp(key, it->first))
-					break ;
-				it++;
-			}
-			return (it);
+		template <class K>
+		iterator		upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.upper_bound(key));
 		}
 
 		const_iterator	upper_bound(const key_type& key) const {
-			const_iterator	it(begin()), ite(end());
+			return (_tree.upper_bound(key));
+		}
 
-			while (it != ite)
-			{
-				if (_key_comp(key, it->first))
-					break ;
-				it++;
-			}
-			return (it);
+		template <class K>
+		const_iterator	upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.upper_bound(key));
 		}
 
+		/****************************************************************************\
+		**								Set operations								**
+		\****************************************************************************/
+
+		/*
+		** In-place set algebra with another map, in O(m log(n / m + 1))
+		** comparisons for m the smaller of the two sizes; other is left
+		** untouched. A key present in both keeps the mapped value of *this.
+		** threads > 1 spreads the work over up to that many threads.
+		*/
+		void	set_union(const map& other, unsigned threads = 1) { _tree.unite(other._tree, threads); }
+
+		void	set_intersection(const map& other, unsigned threads = 1) { _tree.intersect(other._tree, threads); }
+
+		void	set_difference(const map& other, unsigned threads = 1) { _tree.subtract(other._tree, threads); }
+
+		/****************************************************************************\
+		**								Order statistics							**
+		\****************************************************************************/
+
+		/*
+		** Only usable with the rb_subtree_size augmentation; all O(log n).
+		*/
+		iterator	nth(size_type n) { return (_tree.nth(n)); }
+
+		const_iterator	nth(size_type n) const { return (_tree.nth(n)); }
+
+		size_type	rank(const key_type& key) const { return (_tree.rank(key)); }
+
+		size_type	count_range(const key_type& lo, const key_type& hi) const { return (_tree.count_range(lo, hi)); }
+
+		/****************************************************************************\
+		**									Traversal								**
+		\****************************************************************************/
+
+		/*
+		** Hand every element, or those with keys in [lo, hi), to visit in
+		** order and return it; faster than iterating, as the walk does not
+		** climb back through parent links. The visitor may change the mapped
+		** values but must not insert or erase.
+		*/
+		template <class Visitor>
+		Visitor	for_each(Visitor visit) { return (_tree.for_each(visit)); }
+
+		template <class Visitor>
+		Visitor	for_each(Visitor visit) const { return (_tree.for_each(visit)); }
+
+		template <class Visitor>
+		Visitor	for_each_in_range(const key_type& lo, const key_type& hi, Visitor visit) { return (_tree.for_each_in_range(lo, hi, visit)); }
+
+		template <class Visitor>
+		Visitor	for_each_in_range(const key_type& lo, const key_type& hi, Visitor visit) const { return (_tree.for_each_in_range(lo, hi, visit)); }
+
+		/****************************************************************************\
+		**									Aggregates								**
+		\****************************************************************************/
+
+		/*
+		** Only usable with an ft::rb_aggregate augmentation. aggregate(lo, hi)
+		** folds the elements with keys in [lo, hi) in O(log n). A value
+		** changed in place, through an iterator or operator[], is only seen
+		** by the aggregates once refresh() has been called on its iterator.
+		** The template overload only exists for transparent comparators.
+		*/
+		typename rb_aggregate_result<Augment>::type	aggregate(const key_type& lo, const key_type& hi) const { return (_tree.aggregate(lo, hi)); }
+
+		template <class K>
+		typename rb_aggregate_result<Augment>::type	aggregate(const K& lo, const K& hi,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const { return (_tree.aggregate(lo, hi)); }
+
+		void	refresh(iterator pos) { _tree.refresh(pos); }
+
 		/****************************************************************************\
 		**									Observers								**
 		\****************************************************************************/
@@ -267,56 +526,51 @@ namespace ft
 
 	private :
 
-		value_type	get_value_type(const key_type &key) const
-		{
-			return (ft::make_pair(key, mapped_type()));
-		}
-
 		Rb_tree			_tree;
 		allocator_type	_alloc_pair;
 		key_compare		_key_comp;
 	};
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator==(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator==(const map<Key, T, Compare, Alloc, Augment> &lhs, const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		if (lhs.size() != rhs.size())
 			return (false);
 		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator!=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator!=(const map<Key, T, Compare, Alloc, Augment> &lhs, const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return (!(lhs == rhs));
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator<(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator<(const map<Key, T, Compare, Alloc, Augment> &lhs, const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator<=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator<=(const map<Key, T, Compare, Alloc, Augment> &lhs, const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return (!(rhs < lhs));
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator>(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator>(const map<Key, T, Compare, Alloc, Augment> &lhs, const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return (rhs < lhs);
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool	operator>=(const map<Key, T, Compare, Alloc> &lhs, const map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	bool	operator>=(const map<Key, T, Compare, Alloc, Augment> &lhs, const map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		return (!(lhs < rhs));
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	void	swap(map<Key, T, Compare, Alloc> &lhs, map<Key, T, Compare, Alloc> &rhs)
+	template <class Key, class T, class Compare, class Alloc, class Augment>
+	void	swap(map<Key, T, Compare, Alloc, Augment> &lhs, map<Key, T, Compare, Alloc, Augment> &rhs)
 	{
 		lhs.swap(rhs);
 	}
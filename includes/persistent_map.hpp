@@ -0,0 +1,299 @@
+#ifndef PERSISTENT_MAP_H
+# define PERSISTENT_MAP_H
+
+# include <iostream>
+# include <memory>
+# include <algorithm>
+# include <cstddef>
+# include <limits>
+# include <stdexcept>
+# include "pair.hpp"
+# include "utilities.hpp"
+# include "_Pt_tree.hpp"
+
+namespace ft
+{
+	/*
+	** An ordered map whose versions share structure: copying one, or taking
+	** a snapshot(), is O(1), and an update copies only the O(log n) nodes on
+	** its path. Elements are read-only, hence no operator[] and only const
+	** iterators; insert_or_assign() replaces a value.
+	**
+	** A writer thread may keep updating a map while reader threads take
+	** snapshots of it and read them without any locking; a version's nodes
+	** are reclaimed when the last map holding them goes away.
+	*/
+	template<class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class persistent_map {
+	public:
+		class value_compare;
+		typedef Key													key_type;
+		typedef T													mapped_type;
+		typedef pair<const key_type, mapped_type>					value_type;
+		typedef Compare												key_compare;
+		typedef Allocator											allocator_type;
+		typedef typename allocator_type::reference					reference;
+		typedef typename allocator_type::const_reference			const_reference;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef PTree<key_type, value_type, select_first<value_type>, key_compare, allocator_type>	pt_tree;
+		typedef typename pt_tree::const_iterator					iterator;
+		typedef typename pt_tree::const_iterator					const_iterator;
+		typedef typename pt_tree::const_reverse_iterator			reverse_iterator;
+		typedef typename pt_tree::const_reverse_iterator			const_reverse_iterator;
+
+		class value_compare
+			: public std::binary_function<value_type, value_type, bool>
+		{
+			friend class persistent_map;
+
+		protected:
+			key_compare	comp;
+
+			value_compare(key_compare c) : comp(c) {};
+
+		public:
+			bool operator()(const value_type& lhs, const value_type& rhs) const { return comp(lhs.first, rhs.first); }
+		};
+
+	public:
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit persistent_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(comp, alloc), _alloc_pair(alloc), _key_comp(comp) {}
+
+		template <class InputIterator>
+		persistent_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+			: _tree(comp, alloc), _alloc_pair(alloc), _key_comp(comp) {
+
+			insert(first, last);
+		}
+
+		persistent_map(const persistent_map& other)
+			: _tree(other._tree), _alloc_pair(other._alloc_pair), _key_comp(other._key_comp) {}
+
+		~persistent_map() {}
+
+		persistent_map	&operator=(const persistent_map &other)
+		{
+			if (this != &other)
+			{
+				_tree = other._tree;
+				_key_comp = other._key_comp;
+				_alloc_pair = other._alloc_pair;
+			}
+			return (*this);
+		}
+
+		allocator_type	get_allocator() const { return _alloc_pair; }
+
+		/*
+		** The current version, frozen: later updates to *this do not show in
+		** it. Safe to call while another thread updates *this.
+		*/
+		persistent_map	snapshot() const { return (persistent_map(*this)); }
+
+		/****************************************************************************\
+		**								Element access								**
+		\****************************************************************************/
+
+		const mapped_type&	at(const key_type& k) const
+		{
+			const typename pt_tree::tree_node	*found = _tree.search(k);
+			if (found)
+				return (found->data.second);
+			throw(std::out_of_range("persistent_map::at:  key not found"));
+		}
+
+		/****************************************************************************\
+		**									Iterators								**
+		\****************************************************************************/
+
+		const_iterator	begin() const { return (_tree.begin()); }
+
+		const_iterator	end() const { return (_tree.end()); }
+
+		const_reverse_iterator rbegin() const { return (_tree.rbegin()); }
+
+		const_reverse_iterator rend() const { return (_tree.rend()); }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		bool empty() const { return (_tree.empty()); }
+
+		size_type	size() const { return (_tree.size()); }
+
+		size_type	max_size() const { return (_tree.max_size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	clear() {
+			_tree.clear();
+		}
+
+		pair<const_iterator, bool>	insert(const value_type& val)
+		{
+			bool	inserted = _tree.insert(val, false);
+
+			return (ft::make_pair(_tree.find(val.first), inserted));
+		}
+
+		template <class M>
+		pair<const_iterator, bool>	insert_or_assign(const key_type& k, const M& obj)
+		{
+			bool	inserted = _tree.insert(value_type(k, obj), true);
+
+			return (ft::make_pair(_tree.find(k), inserted));
+		}
+
+		template<class InputIt>
+		void	insert(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			for (; first != last; ++first)
+				_tree.insert(*first, false);
+		}
+
+		size_type	erase(const key_type& key)
+		{
+			return (_tree.erase(key));
+		}
+
+		template <class K>
+		size_type	erase(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0)
+		{
+			return (_tree.erase(key));
+		}
+
+		void	swap(persistent_map& other)
+		{
+			_tree.swap(other._tree);
+			ft::swap_elements(_alloc_pair, other._alloc_pair);
+			ft::swap_elements(_key_comp, other._key_comp);
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count( const key_type& key ) const {
+			return (_tree.search(key) ? 1 : 0);
+		}
+
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.search(key) ? 1 : 0);
+		}
+
+		const_iterator	find(const key_type& key) const {
+			return (_tree.find(key));
+		}
+
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key));
+		}
+
+		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.equal_range(key));
+		}
+
+		const_iterator	lower_bound(const key_type& key) const {
+			return (_tree.lower_bound(key));
+		}
+
+		template <class K>
+		const_iterator	lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.lower_bound(key));
+		}
+
+		const_iterator	upper_bound(const key_type& key) const {
+			return (_tree.upper_bound(key));
+		}
+
+		template <class K>
+		const_iterator	upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.upper_bound(key));
+		}
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		key_compare	key_comp() const { return _key_comp; };
+
+		value_compare	value_comp() const { return value_compare(_key_comp); }
+
+	private :
+
+		pt_tree			_tree;
+		allocator_type	_alloc_pair;
+		key_compare		_key_comp;
+	};
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator==(const persistent_map<Key, T, Compare, Alloc> &lhs, const persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator!=(const persistent_map<Key, T, Compare, Alloc> &lhs, const persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator<(const persistent_map<Key, T, Compare, Alloc> &lhs, const persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator<=(const persistent_map<Key, T, Compare, Alloc> &lhs, const persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator>(const persistent_map<Key, T, Compare, Alloc> &lhs, const persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	bool	operator>=(const persistent_map<Key, T, Compare, Alloc> &lhs, const persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class Key, class T, class Compare, class Alloc>
+	void	swap(persistent_map<Key, T, Compare, Alloc> &lhs, persistent_map<Key, T, Compare, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -13,7 +13,13 @@
 
 namespace ft
 {
-	template <class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+	/*
+	** Augment selects an optional per-node augmentation of the underlying
+	** tree: ft::rb_subtree_size enables nth(), rank() and count_range(),
+	** ft::rb_aggregate<Monoid> enables aggregate().
+	*/
+	template <class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key>,
+		class Augment = rb_no_augment>
 	class set {
 	public:
 		typedef Key													key_type;
@@ -28,12 +34,14 @@ namespace ft
 		typedef typename allocator_type::size_type					size_type;
 		typedef typename allocator_type::difference_type			difference_type;
 
-		typedef	Node<value_type>									tree_node;
-		typedef RBTree<value_type, value_compare, allocator_type>	rb_tree;
+		typedef	Node<value_type, Augment>							tree_node;
+		typedef RBTree<key_type, value_type, identity<value_type>, key_compare, allocator_type, Augment>	rb_tree;
 		typedef typename rb_tree::const_iterator					iterator;
 		typedef typename rb_tree::const_iterator					const_iterator;
 		typedef ft::reverse_iterator<iterator>						reverse_iterator;
 		typedef ft::reverse_iterator<const_iterator>				const_reverse_iterator;
+		typedef typename rb_tree::node_handle						node_type;
+		typedef RBInsertReturn<iterator, node_type>					insert_return_type;
 
 	public:
 		/****************************************************************************\
@@ -103,7 +111,21 @@ namespace ft
 		\****************************************************************************/
 
 		void	clear() {
-			_tree.clear(_tree.root());
+			_tree.clear();
+		}
+
+		void	reserve(size_type n) {
+			_tree.reserve(n);
+		}
+
+		/*
+		** clear() then insert(first, last), reusing the nodes cleared.
+		*/
+		template<class InputIt>
+		void	assign(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			_tree.assign(first, last);
 		}
 
 		pair<iterator, bool>	insert(const value_type& val)
@@ -123,14 +145,14 @@ namespace ft
 			_tree.insert(first, last);
 		}
 
-		void	erase(iterator pos)
+		iterator	erase(iterator pos)
 		{
-			_tree.erase(*pos);
+			return (_tree.erase(pos));
 		}
 
-		void	erase(iterator first, iterator last)
+		iterator	erase(iterator first, iterator last)
 		{
-			_tree.erase(first, last);
+			return (_tree.erase(first, last));
 		}
 
 		size_type	erase(const key_type& key)
@@ -138,6 +160,64 @@ namespace ft
 			return (_tree.erase(key));
 		}
 
+		template <class K>
+		size_type	erase(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0)
+		{
+			return (_tree.erase(key));
+		}
+
+		/*
+		** Moves elements between sets of the same type by relinking their
+		** nodes: nothing is copied or allocated (see RBTree::extract()).
+		** Before C++11, insert() only takes a handle held in a variable.
+		*/
+		node_type	extract(const_iterator pos)
+		{
+			return (_tree.extract(pos));
+		}
+
+		node_type	extract(const key_type& key)
+		{
+			return (_tree.extract(key));
+		}
+
+		insert_return_type	insert(node_type& handle)
+		{
+			ft::pair<iterator, bool>	res = _tree.insert(handle);
+			insert_return_type			ret(res.first, res.second);
+
+			if (!res.second)
+				ret.node.swap(handle);
+			return (ret);
+		}
+
+		iterator	insert(const_iterator hint, node_type& handle)
+		{
+			return (_tree.insert(hint, handle));
+		}
+
+# if __cplusplus >= 201103L
+		insert_return_type	insert(node_type&& handle)
+		{
+			return (insert(handle));
+		}
+
+		iterator	insert(const_iterator hint, node_type&& handle)
+		{
+			return (insert(hint, handle));
+		}
+# endif
+
+		/*
+		** Moves in every element of source whose key is missing here; the
+		** others stay in source.
+		*/
+		void	merge(set& source)
+		{
+			_tree.merge(source._tree);
+		}
+
 		void	swap(set& other)
 		{
 			_tree.swap(other._tree);
@@ -148,77 +228,198 @@ namespace ft
 		\****************************************************************************/
 
 		size_type	count( const key_type& key ) const {
-			tree_node	*found(_tree.search(_tree.root(), key));
+			tree_node	*found(_tree.search(key));
 
 			if (found)
 				return (1);
 			return (0);
 		}
 
+		/*
+		** The template overloads below only exist for transparent comparators:
+		** they look a foreign key up as is, without building a key_type.
+		*/
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.search(key) ? 1 : 0);
+		}
+
 		iterator	find(const key_type& key) {
 			return (_tree.find(key));
 		}
 
+		template <class K>
+		iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.find(key));
+		}
+
 		const_iterator	find (const key_type& key) const {
 			return (_tree.find(key));
 		}
 
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(key));
+		}
+
+		/*
+		** Looks key up from hint rather than from the root: O(log d) for a
+		** key d elements away from hint. Any hint is correct, end() included.
+		*/
+		iterator	find(const_iterator hint, const key_type& key) {
+			return (_tree.find(hint, key));
+		}
+
+		template <class K>
+		iterator	find(const_iterator hint, const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.find(hint, key));
+		}
+
+		const_iterator	find(const_iterator hint, const key_type& key) const {
+			return (_tree.find(hint, key));
+		}
+
+		template <class K>
+		const_iterator	find(const_iterator hint, const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.find(hint, key));
+		}
+
+		/*
+		** Finger mode, off by default: every lookup (find, count) starts
+		** from where the previous one ended, which makes runs of nearby keys
+		** cheap (see RBTree::finger_search()). Lookups then update the set,
+		** so a set in finger mode must not be read from several threads at once.
+		*/
+		void	finger_search(bool on) { _tree.finger_search(on); }
+
+		bool	finger_search() const { return (_tree.finger_search()); }
+
 		ft::pair<iterator,iterator>	equal_range(const key_type& key) {
-			return (ft::make_pair(lower_bound(key), upper_bound(key)));
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<iterator,iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.equal_range(key));
 		}
 
 		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
-			return (ft::make_pair(lower_bound(key), upper_bound(key)));
+			return (_tree.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.equal_range(key));
 		}
 
 		iterator		lower_bound(const key_type& key) {
-			iterator	it(begin()), ite(end());
+			return (_tree.lower_bound(key));
+		}
 
-			while (it != ite)
-			{
-				if (!_key_comp(*it, key))
-					break ;
-				it++;
-			}
-			return (it);
+		template <class K>
+		iterator		lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.lower_bound(key));
 		}
 
 		const_iterator	lower_bound(const key_type& key) const {
-			const_iterator	it(begin()), ite(end());
+			return (_tree.lower_bound(key));
+		}
 
-			while (it != ite)
-			{
-				if (!_key_comp(*it, key))
-					break ;
-				it++;
-			}
-			return (it);
+		template <class K>
+		const_iterator	lower_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.lower_bound(key));
 		}
 
 		iterator		upper_bound(const key_type& key) {
-			iterator	it(begin()), ite(end());
+			return (_tree.upper_bound(key));
+		}
 
-			while (it != ite)
-			{
-				if (_key_comp(key, *it))
-					break ;
-				it++;
-			}
-			return (it);
+		template <class K>
+		iterator		upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) {
+			return (_tree.upper_bound(key));
 		}
 
 		const_iterator	upper_bound(const key_type& key) const {
-			const_iterator	it(begin()), ite(end());
+			return (_tree.upper_bound(key));
+		}
 
-			while (it != ite)
-			{
-				if (_key_comp(key, *it))
-					break ;
-				it++;
-			}
-			return (it);
+		template <class K>
+		const_iterator	upper_bound(const K& key,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const {
+			return (_tree.upper_bound(key));
 		}
 
+		/****************************************************************************\
+		**								Set operations								**
+		\****************************************************************************/
+
+		/*
+		** In-place set algebra with another set, in O(m log(n / m + 1))
+		** comparisons for m the smaller of the two sizes; other is left
+		** untouched.
+		** threads > 1 spreads the work over up to that many threads.
+		*/
+		void	set_union(const set& other, unsigned threads = 1) { _tree.unite(other._tree, threads); }
+
+		void	set_intersection(const set& other, unsigned threads = 1) { _tree.intersect(other._tree, threads); }
+
+		void	set_difference(const set& other, unsigned threads = 1) { _tree.subtract(other._tree, threads); }
+
+		/****************************************************************************\
+		**								Order statistics							**
+		\****************************************************************************/
+
+		/*
+		** Only usable with the rb_subtree_size augmentation; all O(log n).
+		*/
+		iterator	nth(size_type n) { return (_tree.nth(n)); }
+
+		const_iterator	nth(size_type n) const { return (_tree.nth(n)); }
+
+		size_type	rank(const key_type& key) const { return (_tree.rank(key)); }
+
+		size_type	count_range(const key_type& lo, const key_type& hi) const { return (_tree.count_range(lo, hi)); }
+
+		/****************************************************************************\
+		**									Traversal								**
+		\****************************************************************************/
+
+		/*
+		** Hand every element, or those in [lo, hi), to visit in order and
+		** return it; faster than iterating, as the walk does not climb back
+		** through parent links. The visitor must not insert or erase.
+		*/
+		template <class Visitor>
+		Visitor	for_each(Visitor visit) const { return (_tree.for_each(visit)); }
+
+		template <class Visitor>
+		Visitor	for_each_in_range(const key_type& lo, const key_type& hi, Visitor visit) const { return (_tree.for_each_in_range(lo, hi, visit)); }
+
+		/****************************************************************************\
+		**									Aggregates								**
+		\****************************************************************************/
+
+		/*
+		** Only usable with an ft::rb_aggregate augmentation: folds the
+		** elements in [lo, hi) in O(log n). The template overload only exists
+		** for transparent comparators.
+		*/
+		typename rb_aggregate_result<Augment>::type	aggregate(const key_type& lo, const key_type& hi) const { return (_tree.aggregate(lo, hi)); }
+
+		template <class K>
+		typename rb_aggregate_result<Augment>::type	aggregate(const K& lo, const K& hi,
+			typename ft::enable_if<ft::is_transparent<key_compare>::value, K>::value* = 0) const { return (_tree.aggregate(lo, hi)); }
+
 		/****************************************************************************\
 		**									Observers								**
 		\****************************************************************************/
@@ -233,46 +434,46 @@ namespace ft
 		key_compare		_key_comp;
 	};
 
-	template <class Key, class Compare, class Alloc>
-	bool	operator==(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
+	template <class Key, class Compare, class Alloc, class Augment>
+	bool	operator==(const set<Key, Compare, Alloc, Augment> &lhs, const set<Key, Compare, Alloc, Augment> &rhs)
 	{
 		if (lhs.size() != rhs.size())
 			return (false);
 		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool	operator!=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
+	template <class Key, class Compare, class Alloc, class Augment>
+	bool	operator!=(const set<Key, Compare, Alloc, Augment> &lhs, const set<Key, Compare, Alloc, Augment> &rhs)
 	{
 		return (!(lhs == rhs));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool	operator<(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
+	template <class Key, class Compare, class Alloc, class Augment>
+	bool	operator<(const set<Key, Compare, Alloc, Augment> &lhs, const set<Key, Compare, Alloc, Augment> &rhs)
 	{
 		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool	operator<=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
+	template <class Key, class Compare, class Alloc, class Augment>
+	bool	operator<=(const set<Key, Compare, Alloc, Augment> &lhs, const set<Key, Compare, Alloc, Augment> &rhs)
 	{
 		return (!(rhs < lhs));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool	operator>(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
+	template <class Key, class Compare, class Alloc, class Augment>
+	bool	operator>(const set<Key, Compare, Alloc, Augment> &lhs, const set<Key, Compare, Alloc, Augment> &rhs)
 	{
 		return (rhs < lhs);
 	}
 
-	template <class Key, class Compare, class Alloc>
-	bool	operator>=(const set<Key, Compare, Alloc> &lhs, const set<Key, Compare, Alloc> &rhs)
+	template <class Key, class Compare, class Alloc, class Augment>
+	bool	operator>=(const set<Key, Compare, Alloc, Augment> &lhs, const set<Key, Compare, Alloc, Augment> &rhs)
 	{
 		return (!(lhs < rhs));
 	}
 
-	template <class Key, class Compare, class Alloc>
-	void	swap(set<Key, Compare, Alloc> &lhs, set<Key, Compare, Alloc> &rhs)
+	template <class Key, class Compare, class Alloc, class Augment>
+	void	swap(set<Key, Compare, Alloc, Augment> &lhs, set<Key, Compare, Alloc, Augment> &rhs)
 	{
 		lhs.swap(rhs);
 	}
@@ -0,0 +1,470 @@
+#ifndef SHARDED_MAP_H
+# define SHARDED_MAP_H
+
+# include <memory>
+# include <vector>
+# include <algorithm>
+# include <functional>
+# include <cstddef>
+# include <pthread.h>
+# include "pair.hpp"
+# include "utilities.hpp"
+# include "map.hpp"
+
+namespace ft
+{
+	/*
+	** Reader-writer lock over pthread_rwlock_t, with scoped guards.
+	*/
+	class rw_lock
+	{
+		public:
+			rw_lock() { pthread_rwlock_init(&_lock, NULL); }
+
+			~rw_lock() { pthread_rwlock_destroy(&_lock); }
+
+			void	lock_shared() { pthread_rwlock_rdlock(&_lock); }
+
+			void	lock() { pthread_rwlock_wrlock(&_lock); }
+
+			void	unlock() { pthread_rwlock_unlock(&_lock); }
+
+		private:
+			rw_lock(const rw_lock &);
+			rw_lock	&operator=(const rw_lock &);
+
+			pthread_rwlock_t	_lock;
+	};
+
+	class read_guard
+	{
+		public:
+			explicit read_guard(rw_lock &lock) : _lock(lock) { _lock.lock_shared(); }
+
+			~read_guard() { _lock.unlock(); }
+
+		private:
+			read_guard(const read_guard &);
+			read_guard	&operator=(const read_guard &);
+
+			rw_lock	&_lock;
+	};
+
+	class write_guard
+	{
+		public:
+			explicit write_guard(rw_lock &lock) : _lock(lock) { _lock.lock(); }
+
+			~write_guard() { _lock.unlock(); }
+
+		private:
+			write_guard(const write_guard &);
+			write_guard	&operator=(const write_guard &);
+
+			rw_lock	&_lock;
+	};
+
+	/*
+	** A thread-safe ordered map made of independent ft::map shards, each
+	** behind its own reader-writer lock; a key's shard comes from its hash,
+	** so operations on different keys rarely wait on each other. Point
+	** operations lock a single shard and hand values out by copy, as a
+	** reference would outlive the lock.
+	**
+	** Ordered traversal goes through a view, which read-locks every shard
+	** for its lifetime and merges the shards on the fly: a consistent
+	** snapshot that blocks writers, not readers, while it lives. Do not
+	** write to the map from a thread that holds a view.
+	*/
+	template <class Key, class T, class Compare = std::less<Key>, class Hash = std::hash<Key>,
+		class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class sharded_map {
+	public:
+		typedef Key													key_type;
+		typedef T													mapped_type;
+		typedef pair<const key_type, mapped_type>					value_type;
+		typedef Compare												key_compare;
+		typedef Hash												hasher;
+		typedef Allocator											allocator_type;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+		typedef ft::map<key_type, mapped_type, key_compare, allocator_type>	shard_map;
+
+	private:
+		/*
+		** The padding keeps the locks of neighbouring shards off each
+		** other's cache line.
+		*/
+		struct shard
+		{
+			mutable rw_lock	lock;
+			shard_map		map;
+			unsigned char	pad[64];
+		};
+
+	public:
+		class const_iterator;
+		class view;
+
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit sharded_map(size_type shards = 16, const key_compare& comp = key_compare(), const hasher& hash = hasher(),
+			const allocator_type& alloc = allocator_type())
+			: _shards(NULL), _count(shards ? shards : 1), _key_comp(comp), _hash(hash), _alloc(alloc)
+		{
+			_shards = new shard[_count];
+			for (size_type i = 0; i < _count; ++i)
+				_shards[i].map = shard_map(comp, alloc);
+		}
+
+		~sharded_map()
+		{
+			delete[] _shards;
+		}
+
+		allocator_type	get_allocator() const { return _alloc; }
+
+		size_type	shard_count() const { return _count; }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		/*
+		** Shards are summed one after the other, so under concurrent writes
+		** the total is only a close estimate; take a view for an exact one.
+		*/
+		size_type	size() const
+		{
+			size_type	total = 0;
+
+			for (size_type i = 0; i < _count; ++i)
+			{
+				read_guard	guard(_shards[i].lock);
+
+				total += _shards[i].map.size();
+			}
+			return (total);
+		}
+
+		bool	empty() const { return (!size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	clear()
+		{
+			for (size_type i = 0; i < _count; ++i)
+			{
+				write_guard	guard(_shards[i].lock);
+
+				_shards[i].map.clear();
+			}
+		}
+
+		bool	insert(const value_type& val)
+		{
+			shard		&s = shard_of(val.first);
+			write_guard	guard(s.lock);
+
+			return (s.map.insert(val).second);
+		}
+
+		template <class M>
+		bool	insert_or_assign(const key_type& k, const M& obj)
+		{
+			shard		&s = shard_of(k);
+			write_guard	guard(s.lock);
+
+			return (s.map.insert_or_assign(k, obj).second);
+		}
+
+		size_type	erase(const key_type& key)
+		{
+			shard		&s = shard_of(key);
+			write_guard	guard(s.lock);
+
+			return (s.map.erase(key));
+		}
+
+		/*
+		** Runs f(mapped_type &) on the value of k under the shard's write
+		** lock, inserting a value-initialized one first if k is missing.
+		*/
+		template <class F>
+		void	update(const key_type& k, F f)
+		{
+			shard		&s = shard_of(k);
+			write_guard	guard(s.lock);
+
+			f(s.map[k]);
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count(const key_type& key) const
+		{
+			const shard	&s = shard_of(key);
+			read_guard	guard(s.lock);
+
+			return (s.map.count(key));
+		}
+
+		/*
+		** Copies the value of key into out; returns false when key is missing.
+		*/
+		bool	get(const key_type& key, mapped_type& out) const
+		{
+			const shard	&s = shard_of(key);
+			read_guard	guard(s.lock);
+
+			typename shard_map::const_iterator	it = s.map.find(key);
+
+			if (it == s.map.end())
+				return (false);
+			out = it->second;
+			return (true);
+		}
+
+		/*
+		** Runs f(const value_type &) on the element of k, if any, under the
+		** shard's read lock.
+		*/
+		template <class F>
+		bool	visit(const key_type& key, F f) const
+		{
+			const shard	&s = shard_of(key);
+			read_guard	guard(s.lock);
+
+			typename shard_map::const_iterator	it = s.map.find(key);
+
+			if (it == s.map.end())
+				return (false);
+			f(*it);
+			return (true);
+		}
+
+		/****************************************************************************\
+		**								Ordered traversal							**
+		\****************************************************************************/
+
+		/*
+		** Merges the shards with a min-heap of their current elements, so a
+		** step costs O(log shards). Forward only.
+		*/
+		class const_iterator
+		{
+			public:
+				typedef ft::pair<const Key, T>				value_type;
+				typedef std::forward_iterator_tag			iterator_category;
+				typedef ptrdiff_t							difference_type;
+				typedef const value_type&					reference;
+				typedef const value_type*					pointer;
+				typedef typename shard_map::const_iterator	shard_iterator;
+
+			private:
+				typedef ft::pair<shard_iterator, shard_iterator>	cursor;
+
+				struct cursor_after
+				{
+					key_compare	comp;
+
+					cursor_after(const key_compare &comp) : comp(comp) {}
+
+					bool	operator()(const cursor &a, const cursor &b) const
+					{
+						return (comp(b.first->first, a.first->first));
+					}
+				};
+
+			public:
+				const_iterator() : _heap(), _after(key_compare()) {}
+
+				const_iterator(const key_compare &comp) : _heap(), _after(comp) {}
+
+				/*
+				** Adds the range [first, last) of one shard to the merge.
+				*/
+				void	add(shard_iterator first, shard_iterator last)
+				{
+					if (first == last)
+						return ;
+					_heap.push_back(cursor(first, last));
+					std::push_heap(_heap.begin(), _heap.end(), _after);
+				}
+
+				reference	operator*() const
+				{
+					return (*_heap.front().first);
+				}
+
+				pointer	operator->() const
+				{
+					return &(*_heap.front().first);
+				}
+
+				const_iterator	&operator++()
+				{
+					std::pop_heap(_heap.begin(), _heap.end(), _after);
+					if (++_heap.back().first == _heap.back().second)
+						_heap.pop_back();
+					else
+						std::push_heap(_heap.begin(), _heap.end(), _after);
+					return (*this);
+				}
+
+				const_iterator	operator++(int)
+				{
+					const_iterator	tmp(*this);
+					operator++();
+					return (tmp);
+				}
+
+				bool	operator==(const const_iterator &other) const
+				{
+					if (_heap.empty() || other._heap.empty())
+						return (_heap.empty() == other._heap.empty());
+					return (_heap.front().first.base() == other._heap.front().first.base());
+				}
+
+				bool	operator!=(const const_iterator &other) const
+				{
+					return (!(*this == other));
+				}
+
+			private:
+				std::vector<cursor>	_heap;
+				cursor_after		_after;
+		};
+
+		/*
+		** Read-locks every shard, in index order, until destroyed.
+		*/
+		class view
+		{
+			public:
+				explicit view(const sharded_map &m) : _map(m)
+				{
+					for (size_type i = 0; i < _map._count; ++i)
+						_map._shards[i].lock.lock_shared();
+				}
+
+				~view()
+				{
+					for (size_type i = _map._count; i-- > 0; )
+						_map._shards[i].lock.unlock();
+				}
+
+				size_type	size() const
+				{
+					size_type	total = 0;
+
+					for (size_type i = 0; i < _map._count; ++i)
+						total += _map._shards[i].map.size();
+					return (total);
+				}
+
+				const_iterator	begin() const
+				{
+					const_iterator	it(_map._key_comp);
+
+					for (size_type i = 0; i < _map._count; ++i)
+						it.add(_map._shards[i].map.begin(), _map._shards[i].map.end());
+					return (it);
+				}
+
+				const_iterator	end() const
+				{
+					return (const_iterator(_map._key_comp));
+				}
+
+				const_iterator	lower_bound(const key_type &key) const
+				{
+					const_iterator	it(_map._key_comp);
+
+					for (size_type i = 0; i < _map._count; ++i)
+						it.add(_map._shards[i].map.lower_bound(key), _map._shards[i].map.end());
+					return (it);
+				}
+
+				const_iterator	upper_bound(const key_type &key) const
+				{
+					const_iterator	it(_map._key_comp);
+
+					for (size_type i = 0; i < _map._count; ++i)
+						it.add(_map._shards[i].map.upper_bound(key), _map._shards[i].map.end());
+					return (it);
+				}
+
+				/*
+				** The keys in [lo, hi), in order; only the shards' parts of the
+				** range enter the merge.
+				*/
+				const_iterator	range(const key_type &lo, const key_type &hi) const
+				{
+					const_iterator	it(_map._key_comp);
+
+					if (!_map._key_comp(lo, hi))
+						return (it);
+					for (size_type i = 0; i < _map._count; ++i)
+						it.add(_map._shards[i].map.lower_bound(lo), _map._shards[i].map.lower_bound(hi));
+					return (it);
+				}
+
+			private:
+				view(const view &);
+				view	&operator=(const view &);
+
+				const sharded_map	&_map;
+		};
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		key_compare	key_comp() const { return _key_comp; };
+
+		hasher	hash_function() const { return _hash; }
+
+	private:
+		sharded_map(const sharded_map &);
+		sharded_map	&operator=(const sharded_map &);
+
+		/*
+		** std::hash is the identity on integers here, so the hash is mixed
+		** before it picks a shard.
+		*/
+		size_type	shard_index(const key_type &key) const
+		{
+			unsigned long long	h = static_cast<unsigned long long>(_hash(key));
+
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdULL;
+			h ^= h >> 33;
+			return (static_cast<size_type>(h % _count));
+		}
+
+		shard	&shard_of(const key_type &key)
+		{
+			return (_shards[shard_index(key)]);
+		}
+
+		const shard	&shard_of(const key_type &key) const
+		{
+			return (_shards[shard_index(key)]);
+		}
+
+		shard			*_shards;
+		size_type		_count;
+		key_compare		_key_comp;
+		hasher			_hash;
+		allocator_type	_alloc;
+	};
+}
+
+#endif
@@ -0,0 +1,357 @@
+#ifndef UNORDERED_MAP_H
+# define UNORDERED_MAP_H
+
+# include <iostream>
+# include <memory>
+# include <algorithm>
+# include <functional>
+# include <cstddef>
+# include <limits>
+# include <stdexcept>
+# include "pair.hpp"
+# include "utilities.hpp"
+# include "_Sw_table.hpp"
+
+namespace ft
+{
+	/*
+	** Same interface as ft::map where ordering plays no part, over an
+	** open-addressing hash table (see _Sw_table.hpp): a lookup costs one
+	** hash, one 16-byte read of control bytes and, most of the time, a
+	** single key compare. Elements live in the table itself, so a rehash
+	** moves them and invalidates iterators and references; erasing does
+	** not touch the other elements.
+	*/
+	template<class Key, class T, class Hash = std::hash<Key>, class KeyEqual = ft::equal_to<Key>,
+		class Allocator = std::allocator<ft::pair<const Key, T> > >
+	class unordered_map {
+	public:
+		typedef Key													key_type;
+		typedef T													mapped_type;
+		typedef pair<const key_type, mapped_type>					value_type;
+		typedef Hash												hasher;
+		typedef KeyEqual											key_equal;
+		typedef Allocator											allocator_type;
+		typedef typename allocator_type::reference					reference;
+		typedef typename allocator_type::const_reference			const_reference;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef SWTable<key_type, value_type, select_first<value_type>, hasher, key_equal, allocator_type>	sw_table;
+		typedef typename sw_table::iterator							iterator;
+		typedef typename sw_table::const_iterator					const_iterator;
+
+	private:
+		/*
+		** Heterogeneous lookup needs both the hash and the equality to
+		** declare is_transparent, as with the std unordered containers.
+		*/
+		static const bool	_transparent = ft::is_transparent<hasher>::value && ft::is_transparent<key_equal>::value;
+
+	public:
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit unordered_map(size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& eq = key_equal(),
+			const allocator_type& alloc = allocator_type())
+			: _table(bucket_count, hash, eq, alloc) {}
+
+		template <class InputIterator>
+		unordered_map(InputIterator first, InputIterator last, size_type bucket_count = 0, const hasher& hash = hasher(),
+			const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type())
+			: _table(bucket_count, hash, eq, alloc) {
+
+			_table.insert(first, last);
+		}
+
+		unordered_map(const unordered_map& other)
+			: _table(other._table) {}
+
+		~unordered_map() {}
+
+		unordered_map	&operator=(const unordered_map &other)
+		{
+			if (this != &other)
+				_table = other._table;
+			return (*this);
+		}
+
+		allocator_type	get_allocator() const { return _table.get_allocator(); }
+
+		/****************************************************************************\
+		**								Element access								**
+		\****************************************************************************/
+
+		mapped_type&	at(const key_type& k)
+		{
+			iterator	found = _table.find(k);
+			if (found != end())
+				return (found->second);
+			throw(std::out_of_range("unordered_map::at:  key not found"));
+		}
+
+		const mapped_type&	at(const key_type& k) const
+		{
+			const_iterator	found = _table.find(k);
+			if (found != end())
+				return (found->second);
+			throw(std::out_of_range("unordered_map::at:  key not found"));
+		}
+
+		mapped_type&	operator[] (const key_type& k)
+		{
+			return (try_emplace(k).first->second);
+		}
+
+		/****************************************************************************\
+		**									Iterators								**
+		\****************************************************************************/
+
+		iterator	begin()	{ return (_table.begin()); }
+
+		const_iterator	begin() const { return (_table.begin()); }
+
+		iterator	end() { return (_table.end()); }
+
+		const_iterator	end() const { return (_table.end()); }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		bool empty() const { return (_table.empty()); }
+
+		size_type	size() const { return (_table.size()); }
+
+		size_type	max_size() const { return (_table.max_size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	clear() {
+			_table.clear();
+		}
+
+		pair<iterator, bool>	insert(const value_type& val)
+		{
+			return (_table.insert(val));
+		}
+
+		/*
+		** The hint is of no use to a hash table; it is there for code written
+		** against ft::map.
+		*/
+		iterator	insert(const_iterator, const value_type& val)
+		{
+			return (_table.insert(val).first);
+		}
+
+		/*
+		** try_emplace() and insert_or_assign() probe the table once: on a hit
+		** they hand back the existing slot, and the value is only built when
+		** the key is missing. obj may be an element of the map (see
+		** find_or_emplace()).
+		*/
+		pair<iterator, bool>	try_emplace(const key_type& k)
+		{
+			size_type	pos;
+			const bool	found = _table.find_or_emplace(k, pos, k, mapped_type());
+
+			return (ft::make_pair(_table.iterator_at(pos), !found));
+		}
+
+		template <class M>
+		pair<iterator, bool>	try_emplace(const key_type& k, const M& obj)
+		{
+			size_type	pos;
+			const bool	found = _table.find_or_emplace(k, pos, k, obj);
+
+			return (ft::make_pair(_table.iterator_at(pos), !found));
+		}
+
+		template <class M>
+		pair<iterator, bool>	insert_or_assign(const key_type& k, const M& obj)
+		{
+			size_type	pos;
+
+			if (_table.find_or_emplace(k, pos, k, obj))
+			{
+				iterator	found = _table.iterator_at(pos);
+
+				found->second = obj;
+				return (ft::make_pair(found, false));
+			}
+			return (ft::make_pair(_table.iterator_at(pos), true));
+		}
+
+		template<class InputIt>
+		void	insert(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			_table.insert(first, last);
+		}
+
+		iterator	erase(const_iterator pos)
+		{
+			return (_table.erase(pos));
+		}
+
+		iterator	erase(iterator pos)
+		{
+			return (_table.erase(pos));
+		}
+
+		iterator	erase(const_iterator first, const_iterator last)
+		{
+			return (_table.erase(first, last));
+		}
+
+		size_type	erase(const key_type& key)
+		{
+			return (_table.erase(key));
+		}
+
+		template <class K>
+		size_type	erase(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0)
+		{
+			return (_table.erase(key));
+		}
+
+		void	swap(unordered_map& other)
+		{
+			_table.swap(other._table);
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count( const key_type& key ) const {
+			return (_table.find(key) != end() ? 1 : 0);
+		}
+
+		/*
+		** The template overloads below only exist for transparent hash and
+		** equality: they look a foreign key up as is, without building a
+		** key_type.
+		*/
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0) const {
+			return (_table.find(key) != end() ? 1 : 0);
+		}
+
+		iterator	find(const key_type& key) {
+			return (_table.find(key));
+		}
+
+		template <class K>
+		iterator	find(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0) {
+			return (_table.find(key));
+		}
+
+		const_iterator	find(const key_type& key) const {
+			return (_table.find(key));
+		}
+
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0) const {
+			return (_table.find(key));
+		}
+
+		ft::pair<iterator,iterator>	equal_range(const key_type& key) {
+			return (_table.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<iterator,iterator>	equal_range(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0) {
+			return (_table.equal_range(key));
+		}
+
+		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
+			return (_table.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0) const {
+			return (_table.equal_range(key));
+		}
+
+		/****************************************************************************\
+		**									Hash policy								**
+		\****************************************************************************/
+
+		/*
+		** bucket_count() is the number of slots. The maximum load factor
+		** defaults to 7/8 and is kept within [1/8, 15/16]; setting it
+		** rebuilds the table.
+		*/
+		size_type	bucket_count() const { return (_table.bucket_count()); }
+
+		float	load_factor() const { return (_table.load_factor()); }
+
+		float	max_load_factor() const { return (_table.max_load_factor()); }
+
+		void	max_load_factor(float ml) { _table.max_load_factor(ml); }
+
+		void	rehash(size_type count) { _table.rehash(count); }
+
+		void	reserve(size_type count) { _table.reserve(count); }
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		hasher	hash_function() const { return (_table.hash_function()); }
+
+		key_equal	key_eq() const { return (_table.key_eq()); }
+
+	private :
+
+		sw_table		_table;
+	};
+
+	/*
+	** Equal when they hold the same elements, whatever the order of their
+	** slots.
+	*/
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	bool	operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc> &lhs, const unordered_map<Key, T, Hash, KeyEqual, Alloc> &rhs)
+	{
+		typedef typename unordered_map<Key, T, Hash, KeyEqual, Alloc>::const_iterator	const_iterator;
+
+		if (lhs.size() != rhs.size())
+			return (false);
+		for (const_iterator it = lhs.begin(); it != lhs.end(); ++it)
+		{
+			const_iterator	found = rhs.find(it->first);
+
+			if (found == rhs.end() || !(found->second == it->second))
+				return (false);
+		}
+		return (true);
+	}
+
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	bool	operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc> &lhs, const unordered_map<Key, T, Hash, KeyEqual, Alloc> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+	void	swap(unordered_map<Key, T, Hash, KeyEqual, Alloc> &lhs, unordered_map<Key, T, Hash, KeyEqual, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
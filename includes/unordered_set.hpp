@@ -0,0 +1,243 @@
+#ifndef UNORDERED_SET_H
+# define UNORDERED_SET_H
+
+# include <iostream>
+# include <memory>
+# include <algorithm>
+# include <functional>
+# include <cstddef>
+# include <limits>
+# include "pair.hpp"
+# include "utilities.hpp"
+# include "_Sw_table.hpp"
+
+namespace ft
+{
+	/*
+	** Same interface as ft::set where ordering plays no part, over an
+	** open-addressing hash table (see _Sw_table.hpp). A rehash moves the
+	** elements and invalidates iterators; erasing does not touch the other
+	** elements.
+	*/
+	template <class Key, class Hash = std::hash<Key>, class KeyEqual = ft::equal_to<Key>, class Allocator = std::allocator<Key> >
+	class unordered_set {
+	public:
+		typedef Key													key_type;
+		typedef Key													value_type;
+		typedef Hash												hasher;
+		typedef KeyEqual											key_equal;
+		typedef Allocator											allocator_type;
+		typedef value_type&											reference;
+		typedef const value_type&									const_reference;
+		typedef typename allocator_type::pointer					pointer;
+		typedef typename allocator_type::const_pointer				const_pointer;
+		typedef typename allocator_type::size_type					size_type;
+		typedef typename allocator_type::difference_type			difference_type;
+
+		typedef SWTable<key_type, value_type, identity<value_type>, hasher, key_equal, allocator_type>	sw_table;
+		typedef typename sw_table::const_iterator					iterator;
+		typedef typename sw_table::const_iterator					const_iterator;
+
+	private:
+		static const bool	_transparent = ft::is_transparent<hasher>::value && ft::is_transparent<key_equal>::value;
+
+	public:
+		/****************************************************************************\
+		**								Member functions							**
+		\****************************************************************************/
+
+		explicit unordered_set(size_type bucket_count = 0, const hasher& hash = hasher(), const key_equal& eq = key_equal(),
+			const allocator_type& alloc = allocator_type())
+			: _table(bucket_count, hash, eq, alloc) {}
+
+		template <class InputIterator>
+		unordered_set(InputIterator first, InputIterator last, size_type bucket_count = 0, const hasher& hash = hasher(),
+			const key_equal& eq = key_equal(), const allocator_type& alloc = allocator_type())
+			: _table(bucket_count, hash, eq, alloc) {
+
+			_table.insert(first, last);
+		}
+
+		unordered_set(const unordered_set& other)
+			: _table(other._table) {}
+
+		~unordered_set() {}
+
+		unordered_set	&operator=(const unordered_set &other)
+		{
+			if (this != &other)
+				_table = other._table;
+			return (*this);
+		}
+
+		allocator_type	get_allocator() const { return _table.get_allocator(); }
+
+		/****************************************************************************\
+		**									Iterators								**
+		\****************************************************************************/
+
+		const_iterator	begin() const { return (_table.begin()); }
+
+		const_iterator	end() const { return (_table.end()); }
+
+		/****************************************************************************\
+		**									Capacity								**
+		\****************************************************************************/
+
+		bool empty() const { return (_table.empty()); }
+
+		size_type	size() const { return (_table.size()); }
+
+		size_type	max_size() const { return (_table.max_size()); }
+
+		/****************************************************************************\
+		**									Modifiers								**
+		\****************************************************************************/
+
+		void	clear() {
+			_table.clear();
+		}
+
+		pair<iterator, bool>	insert(const value_type& val)
+		{
+			return (_table.insert(val));
+		}
+
+		/*
+		** The hint is of no use to a hash table; it is there for code written
+		** against ft::set.
+		*/
+		iterator	insert(const_iterator, const value_type& val)
+		{
+			return (_table.insert(val).first);
+		}
+
+		template<class InputIt>
+		void	insert(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::value* = 0)
+		{
+			_table.insert(first, last);
+		}
+
+		iterator	erase(const_iterator pos)
+		{
+			return (_table.erase(pos));
+		}
+
+		iterator	erase(const_iterator first, const_iterator last)
+		{
+			return (_table.erase(first, last));
+		}
+
+		size_type	erase(const key_type& key)
+		{
+			return (_table.erase(key));
+		}
+
+		template <class K>
+		size_type	erase(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0)
+		{
+			return (_table.erase(key));
+		}
+
+		void	swap(unordered_set& other)
+		{
+			_table.swap(other._table);
+		}
+
+		/****************************************************************************\
+		**									Lookup									**
+		\****************************************************************************/
+
+		size_type	count( const key_type& key ) const {
+			return (_table.find(key) != end() ? 1 : 0);
+		}
+
+		/*
+		** The template overloads below only exist for transparent hash and
+		** equality: they look a foreign key up as is, without building a
+		** key_type.
+		*/
+		template <class K>
+		size_type	count(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0) const {
+			return (_table.find(key) != end() ? 1 : 0);
+		}
+
+		const_iterator	find(const key_type& key) const {
+			return (_table.find(key));
+		}
+
+		template <class K>
+		const_iterator	find(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0) const {
+			return (_table.find(key));
+		}
+
+		ft::pair<const_iterator,const_iterator>	equal_range(const key_type& key) const {
+			return (_table.equal_range(key));
+		}
+
+		template <class K>
+		ft::pair<const_iterator,const_iterator>	equal_range(const K& key,
+			typename ft::enable_if<_transparent, K>::value* = 0) const {
+			return (_table.equal_range(key));
+		}
+
+		/****************************************************************************\
+		**									Hash policy								**
+		\****************************************************************************/
+
+		size_type	bucket_count() const { return (_table.bucket_count()); }
+
+		float	load_factor() const { return (_table.load_factor()); }
+
+		float	max_load_factor() const { return (_table.max_load_factor()); }
+
+		void	max_load_factor(float ml) { _table.max_load_factor(ml); }
+
+		void	rehash(size_type count) { _table.rehash(count); }
+
+		void	reserve(size_type count) { _table.reserve(count); }
+
+		/****************************************************************************\
+		**									Observers								**
+		\****************************************************************************/
+
+		hasher	hash_function() const { return (_table.hash_function()); }
+
+		key_equal	key_eq() const { return (_table.key_eq()); }
+
+	private :
+
+		sw_table		_table;
+	};
+
+	template <class Key, class Hash, class KeyEqual, class Alloc>
+	bool	operator==(const unordered_set<Key, Hash, KeyEqual, Alloc> &lhs, const unordered_set<Key, Hash, KeyEqual, Alloc> &rhs)
+	{
+		typedef typename unordered_set<Key, Hash, KeyEqual, Alloc>::const_iterator	const_iterator;
+
+		if (lhs.size() != rhs.size())
+			return (false);
+		for (const_iterator it = lhs.begin(); it != lhs.end(); ++it)
+			if (rhs.find(*it) == rhs.end())
+				return (false);
+		return (true);
+	}
+
+	template <class Key, class Hash, class KeyEqual, class Alloc>
+	bool	operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc> &lhs, const unordered_set<Key, Hash, KeyEqual, Alloc> &rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class Key, class Hash, class KeyEqual, class Alloc>
+	void	swap(unordered_set<Key, Hash, KeyEqual, Alloc> &lhs, unordered_set<Key, Hash, KeyEqual, Alloc> &rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
+
+#endif
@@ -81,7 +81,7 @@ namespace ft {
 	template<> struct is_integral<uint16_t> { static const bool value = true; };
 	template<> struct is_integral<uint32_t> { static const bool value = true; };
 	template<> struct is_integral<unsigned long int> { static const bool value = true; };
-	template<> struct is_integral<uint64_t> { static const bool value = true; };
+	template<> struct is_integral<unsigned long long int> { static const bool value = true; };
 	template<> struct is_integral<bool> { static const bool value = true; };
 
 	/****************************************************************************\
@@ -93,6 +93,57 @@ namespace ft {
 	template<bool, class T = void> struct enable_if {};
 	template<class T> struct enable_if<true, T> { typedef T value; };
 
+	/****************************************************************************\
+	** 																			**
+	**							is_same utilities								**
+	** 																			**
+	\****************************************************************************/
+
+	template<class T, class U> struct is_same { static const bool value = false; };
+	template<class T> struct is_same<T, T> { static const bool value = true; };
+
+	/****************************************************************************\
+	** 																			**
+	**							is_transparent utilities						**
+	** 																			**
+	\****************************************************************************/
+
+	/*
+	** True when Compare declares an is_transparent member type, i.e. it
+	** accepts any key type it can compare, not only the container's key_type.
+	*/
+	template <class Compare>
+	struct is_transparent
+	{
+		private:
+			typedef char	yes;
+			typedef char	(&no)[2];
+
+			template <class U> static yes	test(typename U::is_transparent *);
+			template <class U> static no	test(...);
+
+		public:
+			static const bool	value = (sizeof(test<Compare>(0)) == sizeof(yes));
+	};
+
+	/****************************************************************************\
+	** 																			**
+	**						key extraction utilities							**
+	** 																			**
+	\****************************************************************************/
+
+	template <class Pair>
+	struct select_first
+	{
+		const typename Pair::first_type	&operator()(const Pair &p) const { return p.first; }
+	};
+
+	template <class T>
+	struct identity
+	{
+		const T	&operator()(const T &x) const { return x; }
+	};
+
 	/****************************************************************************\
 	** 																			**
 	**									utils									**
@@ -108,6 +159,19 @@ namespace ft {
 		rhs = tmp;
 	};
 
+	/*
+	** Hints that *p will be read soon; a no-op on compilers without the
+	** builtin.
+	*/
+	inline void	prefetch(const void *p)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(p);
+#else
+		(void)p;
+#endif
+	}
+
 	template <class InputIt>
 	size_t	InputIt_get_len(InputIt first, InputIt last)
 	{
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include "chrono.hpp"
+#include <map.hpp>
+#include <btree_map.hpp>
+
+/*
+** ft::map against ft::btree_map on int keys: random inserts, random
+** lookups (all hits), a full in-order scan and the bytes obtained from the
+** allocator per element, counted through a wrapping allocator.
+**
+** Usage: ./bench_btree_map [n] (default 1000000)
+*/
+
+static size_t	g_bytes = 0;
+
+template <class T>
+struct counting_allocator : public std::allocator<T>
+{
+	template <class U>
+	struct rebind
+	{
+		typedef counting_allocator<U>	other;
+	};
+
+	counting_allocator() {}
+
+	template <class U>
+	counting_allocator(const counting_allocator<U> &) {}
+
+	T	*allocate(size_t n, const void * = 0)
+	{
+		g_bytes += n * sizeof(T);
+		return (std::allocator<T>::allocate(n));
+	}
+
+	void	deallocate(T *p, size_t n)
+	{
+		g_bytes -= n * sizeof(T);
+		std::allocator<T>::deallocate(p, n);
+	}
+};
+
+typedef counting_allocator<ft::pair<const int, int> >								pair_allocator;
+typedef ft::map<int, int, std::less<int>, pair_allocator>						rb_map;
+typedef ft::btree_map<int, int, std::less<int>, pair_allocator>					b_map;
+
+template <class Map>
+static void	run(const char *name, const std::vector<int> &keys)
+{
+	size_t		before = g_bytes;
+	Map			m;
+	long double	start = get_the_time();
+
+	for (size_t i = 0; i < keys.size(); ++i)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+
+	long double	insert = get_the_time() - start;
+	size_t		bytes = g_bytes - before;
+	long		sum = 0;
+
+	start = get_the_time();
+	for (size_t i = 0; i < keys.size(); ++i)
+		sum += m.find(keys[i])->second;
+
+	long double	lookup = get_the_time() - start;
+
+	start = get_the_time();
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->first;
+
+	long double	scan = get_the_time() - start;
+
+	std::cout << std::setw(10) << name
+		<< std::setw(12) << insert << std::setw(12) << lookup << std::setw(12) << scan
+		<< std::setw(14) << static_cast<double>(bytes) / m.size()
+		<< "   (" << sum << ")" << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	const int			n = argc > 1 ? atoi(argv[1]) : 1000000;
+	std::vector<int>	keys;
+
+	srand(42);
+	for (int i = 0; i < n; ++i)
+		keys.push_back(rand());
+	std::cout << "n = " << n << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << std::setw(10) << "" << std::setw(12) << "insert ms" << std::setw(12) << "lookup ms"
+		<< std::setw(12) << "scan ms" << std::setw(14) << "bytes/elem" << std::endl;
+	run<rb_map>("ft::map", keys);
+	run<b_map>("btree_map", keys);
+	return (0);
+}
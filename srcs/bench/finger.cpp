@@ -0,0 +1,82 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include "chrono.hpp"
+#include <map.hpp>
+
+/*
+** Looks up keys of an ft::map<int, int> of n elements in three orders:
+** sequential (every key in turn), clustered (a random walk taking steps
+** of at most 16 elements) and uniformly random. Each order is timed with
+** find() from the root, find() in finger mode, and find(hint, key) given
+** the previous result. Half the keys looked up are absent.
+**
+** Usage: ./bench_finger [n] [lookups] (defaults 1000000 10000000)
+*/
+
+typedef ft::map<int, int>	int_map;
+
+static void	make_keys(std::vector<int> &keys, int n, int lookups, int pattern)
+{
+	int	at = 0;
+
+	keys.clear();
+	for (int i = 0; i < lookups; ++i)
+	{
+		if (pattern == 0)
+			at = (at + 1) % (2 * n);
+		else if (pattern == 1)
+			at = (at + 2 * n + rand() % 33 - 16) % (2 * n);
+		else
+			at = rand() % (2 * n);
+		keys.push_back(at);
+	}
+}
+
+static long double	run(int_map &m, const std::vector<int> &keys, int mode, long &found)
+{
+	long double				start = get_the_time();
+	int_map::const_iterator	hint = m.end();
+
+	m.finger_search(mode == 1);
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		int_map::iterator	it = (mode == 2 ? m.find(hint, keys[i]) : m.find(keys[i]));
+
+		if (it != m.end())
+		{
+			found += it->second;
+			hint = it;
+		}
+	}
+	return (get_the_time() - start);
+}
+
+int	main(int argc, char **argv)
+{
+	const int			n = argc > 1 ? atoi(argv[1]) : 1000000;
+	const int			lookups = argc > 2 ? atoi(argv[2]) : 10000000;
+	const char			*names[] = { "sequential", "clustered", "random" };
+	int_map				m;
+	std::vector<int>	keys;
+
+	for (int i = 0; i < n; ++i)
+		m.insert(ft::make_pair(2 * i, 1));
+	srand(42);
+	std::cout << n << " elements, " << lookups << " lookups (ms)" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << std::setw(12) << "" << std::setw(12) << "root" << std::setw(12) << "finger"
+		<< std::setw(12) << "hint" << std::endl;
+	for (int pattern = 0; pattern < 3; ++pattern)
+	{
+		long	found[3] = { 0, 0, 0 };
+
+		make_keys(keys, n, lookups, pattern);
+		std::cout << std::setw(12) << names[pattern];
+		for (int mode = 0; mode < 3; ++mode)
+			std::cout << std::setw(12) << run(m, keys, mode, found[mode]);
+		std::cout << (found[0] != found[1] || found[0] != found[2] ? "  MISMATCH" : "") << std::endl;
+	}
+	return (0);
+}
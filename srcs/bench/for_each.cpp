@@ -0,0 +1,72 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include "chrono.hpp"
+#include <map.hpp>
+
+/*
+** Full and ranged scans of an ft::map<int, int> filled in random order,
+** through iterators against for_each() and for_each_in_range(). Each pass
+** sums the mapped values so that none of them can be skipped.
+**
+** Usage: ./bench_for_each [n] [passes] (defaults 1000000 20)
+*/
+
+struct summer
+{
+	long	sum;
+
+	summer() : sum(0) {}
+
+	void	operator()(const ft::pair<const int, int> &value) { sum += value.second; }
+};
+
+int	main(int argc, char **argv)
+{
+	const int			n = argc > 1 ? atoi(argv[1]) : 1000000;
+	const int			passes = argc > 2 ? atoi(argv[2]) : 20;
+	ft::map<int, int>	m;
+	long				check = 0;
+
+	srand(42);
+	for (int i = 0; i < n; ++i)
+		m.insert(ft::make_pair(rand(), i));
+
+	const ft::map<int, int>	&cm = m;
+	long double				start = get_the_time();
+
+	for (int p = 0; p < passes; ++p)
+		for (ft::map<int, int>::const_iterator it = cm.begin(); it != cm.end(); ++it)
+			check += it->second;
+
+	long double	iterate = get_the_time() - start;
+
+	start = get_the_time();
+	for (int p = 0; p < passes; ++p)
+		check -= cm.for_each(summer()).sum;
+
+	long double	visit = get_the_time() - start;
+	const int	lo = RAND_MAX / 4;
+	const int	hi = RAND_MAX / 2;
+
+	start = get_the_time();
+	for (int p = 0; p < passes; ++p)
+		for (ft::map<int, int>::const_iterator it = cm.lower_bound(lo); it != cm.end() && it->first < hi; ++it)
+			check += it->second;
+
+	long double	iterate_range = get_the_time() - start;
+
+	start = get_the_time();
+	for (int p = 0; p < passes; ++p)
+		check -= cm.for_each_in_range(lo, hi, summer()).sum;
+
+	long double	visit_range = get_the_time() - start;
+
+	std::cout << m.size() << " elements, " << passes << " passes (ms)" << (check ? " MISMATCH" : "") << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << std::setw(12) << "" << std::setw(12) << "iterator" << std::setw(12) << "for_each" << std::endl;
+	std::cout << std::setw(12) << "full scan" << std::setw(12) << iterate << std::setw(12) << visit << std::endl;
+	std::cout << std::setw(12) << "1/4 range" << std::setw(12) << iterate_range << std::setw(12) << visit_range << std::endl;
+	return (0);
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+#include "chrono.hpp"
+#include <map.hpp>
+#include <frozen_map.hpp>
+
+/*
+** Random lookups in an ft::map<int, int> of n elements, inserted in
+** random order, against the frozen_map made from it: find() through
+** the scalar descent (a comparator std::less does not recognise) and
+** the SIMD one, and lower_bound(). Half the keys looked up are absent.
+**
+** Usage: ./bench_frozen_map [lookups] [n...] (defaults 10000000, and
+** 1000000 10000000 100000000; the largest needs about 5 GB)
+*/
+
+struct plain_less
+{
+	bool	operator()(int lhs, int rhs) const { return (lhs < rhs); }
+};
+
+template <class Map>
+static long double	run_find(const Map &m, const std::vector<int> &keys, long &sum)
+{
+	long double	start = get_the_time();
+
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		typename Map::const_iterator	it = m.find(keys[i]);
+
+		if (it != m.end())
+			sum += it->second;
+	}
+	return (get_the_time() - start);
+}
+
+template <class Map>
+static long double	run_lower_bound(const Map &m, const std::vector<int> &keys, long &sum)
+{
+	long double	start = get_the_time();
+
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		typename Map::const_iterator	it = m.lower_bound(keys[i]);
+
+		if (it != m.end())
+			sum += it->second;
+	}
+	return (get_the_time() - start);
+}
+
+static void	bench(int n, int lookups)
+{
+	std::vector<int>	keys;
+
+	for (int i = 0; i < n; ++i)
+		keys.push_back(2 * i);
+	std::random_shuffle(keys.begin(), keys.end());
+
+	ft::map<int, int, plain_less>	pm;
+
+	for (int i = 0; i < n; ++i)
+		pm.insert(ft::make_pair(keys[i], 1));
+
+	ft::frozen_map<int, int, plain_less>	pf(pm);
+	ft::map<int, int>						m;
+
+	ft::map<int, int, plain_less>().swap(pm);
+	for (int i = 0; i < n; ++i)
+		m.insert(ft::make_pair(keys[i], 1));
+
+	ft::frozen_map<int, int>	f(m);
+
+	keys.clear();
+	for (int i = 0; i < lookups; ++i)
+		keys.push_back(rand() % (2 * n));
+
+	long	sums[5] = { 0, 0, 0, 0, 0 };
+
+	std::cout << std::setw(12) << n;
+	std::cout << std::setw(12) << run_find(m, keys, sums[0]);
+	std::cout << std::setw(12) << run_find(pf, keys, sums[1]);
+	std::cout << std::setw(12) << run_find(f, keys, sums[2]);
+	std::cout << std::setw(12) << run_lower_bound(m, keys, sums[3]);
+	std::cout << std::setw(12) << run_lower_bound(f, keys, sums[4]);
+	std::cout << (sums[0] != sums[1] || sums[0] != sums[2] || sums[3] != sums[4] ? "  MISMATCH" : "") << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	const int			lookups = argc > 1 ? atoi(argv[1]) : 10000000;
+	std::vector<int>	sizes;
+
+	for (int i = 2; i < argc; ++i)
+		sizes.push_back(atoi(argv[i]));
+	if (sizes.empty())
+	{
+		sizes.push_back(1000000);
+		sizes.push_back(10000000);
+		sizes.push_back(100000000);
+	}
+	srand(42);
+	std::cout << lookups << " lookups (ms)" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << std::setw(12) << "n" << std::setw(12) << "map find" << std::setw(12) << "scalar" << std::setw(12) << "simd"
+		<< std::setw(12) << "map lb" << std::setw(12) << "frozen lb" << std::endl;
+	for (size_t i = 0; i < sizes.size(); ++i)
+		bench(sizes[i], lookups);
+	return (0);
+}
@@ -0,0 +1,115 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <string>
+#include <stdlib.h>
+#include "chrono.hpp"
+#include <map.hpp>
+
+/*
+** Refills an ft::map<int, std::string> of n elements over and over, the
+** way a cache gets rebuilt: by assignment from maps of the same size,
+** by assign() from a sorted range, and by clear() followed by one
+** insert() per element. Every allocator call the maps make goes through
+** a counting allocator; the mapped strings allocate on their own and are
+** not counted.
+**
+** Usage: ./bench_refill [n] [rounds] (defaults 100000 50)
+*/
+
+static size_t	g_calls = 0;
+static size_t	g_bytes = 0;
+
+template <class T>
+struct counting_allocator : std::allocator<T>
+{
+	template <class U>
+	struct rebind
+	{
+		typedef counting_allocator<U>	other;
+	};
+
+	counting_allocator() {}
+
+	template <class U>
+	counting_allocator(const counting_allocator<U> &) {}
+
+	T	*allocate(size_t n, const void * = 0)
+	{
+		++g_calls;
+		g_bytes += n * sizeof(T);
+		return (std::allocator<T>::allocate(n));
+	}
+};
+
+typedef ft::pair<const int, std::string>														value_type;
+typedef ft::map<int, std::string, std::less<int>, counting_allocator<value_type> >				cache_map;
+typedef std::vector<ft::pair<int, std::string>, counting_allocator<ft::pair<int, std::string> > >	source_vector;
+
+static void	fill(cache_map &m, source_vector &v, int n, int seed)
+{
+	srand(seed);
+	for (int i = 0; i < n; ++i)
+		m.insert(value_type(rand(), "value"));
+	for (cache_map::iterator it = m.begin(); it != m.end(); ++it)
+		v.push_back(ft::make_pair(it->first, it->second));
+}
+
+static void	report(const char *name, size_t calls, size_t bytes, long double ms, int rounds)
+{
+	std::cout << std::setw(20) << name
+		<< std::setw(14) << calls
+		<< std::setw(14) << std::setprecision(1) << bytes / (1024.0 * 1024.0)
+		<< std::setw(12) << ms / rounds << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	const int		n = argc > 1 ? atoi(argv[1]) : 100000;
+	const int		rounds = argc > 2 ? atoi(argv[2]) : 50;
+	cache_map		a;
+	cache_map		b;
+	source_vector	va;
+	source_vector	vb;
+
+	fill(a, va, n, 1);
+	fill(b, vb, n, 2);
+
+	cache_map	m(a);
+	size_t		calls = g_calls;
+	size_t		bytes = g_bytes;
+	long double	start = get_the_time();
+
+	std::cout << std::fixed << n << " elements, " << rounds << " rounds" << std::endl;
+	std::cout << std::setw(20) << "" << std::setw(14) << "alloc calls" << std::setw(14) << "MiB"
+		<< std::setw(12) << "ms/round" << std::endl;
+	for (int r = 0; r < rounds; ++r)
+		m = (r % 2 ? a : b);
+	report("operator=", g_calls - calls, g_bytes - bytes, get_the_time() - start, rounds);
+
+	calls = g_calls;
+	bytes = g_bytes;
+	start = get_the_time();
+	for (int r = 0; r < rounds; ++r)
+	{
+		const source_vector	&v = (r % 2 ? va : vb);
+
+		m.assign(v.begin(), v.end());
+	}
+	report("assign(range)", g_calls - calls, g_bytes - bytes, get_the_time() - start, rounds);
+
+	calls = g_calls;
+	bytes = g_bytes;
+	start = get_the_time();
+	for (int r = 0; r < rounds; ++r)
+	{
+		const source_vector	&v = (r % 2 ? va : vb);
+
+		m.clear();
+		for (size_t i = 0; i < v.size(); ++i)
+			m.insert(value_type(v[i].first, v[i].second));
+	}
+	report("clear + insert", g_calls - calls, g_bytes - bytes, get_the_time() - start, rounds);
+	return (0);
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <stdlib.h>
+#include "chrono.hpp"
+#include <set.hpp>
+
+/*
+** Times set_union, set_intersection and set_difference of two random
+** ft::set<int> of about n elements each (half their keys in common), with
+** 1, 2, 4, 8 and 16 threads. The operand is copied before each run and
+** the copy is not timed.
+**
+** Usage: ./bench_set_ops [n] (default 5000000)
+*/
+
+typedef ft::set<int>	int_set;
+
+static void	fill(int_set &s, int n, int seed)
+{
+	std::vector<int>	keys;
+
+	srand(seed);
+	for (int k = 0; keys.size() < static_cast<size_t>(n); ++k)
+		if (rand() % 2)
+			keys.push_back(k);
+	s.insert(keys.begin(), keys.end());
+}
+
+static long double	run(const int_set &a, const int_set &b, int op, unsigned threads, size_t &result)
+{
+	int_set		c(a);
+	long double	start = get_the_time();
+
+	if (op == 0)
+		c.set_union(b, threads);
+	else if (op == 1)
+		c.set_intersection(b, threads);
+	else
+		c.set_difference(b, threads);
+
+	long double	elapsed = get_the_time() - start;
+
+	result = c.size();
+	return (elapsed);
+}
+
+int	main(int argc, char **argv)
+{
+	const int		n = argc > 1 ? atoi(argv[1]) : 5000000;
+	const char		*names[] = { "set_union", "set_intersection", "set_difference" };
+	const unsigned	threads[] = { 1, 2, 4, 8, 16 };
+	int_set			a;
+	int_set			b;
+
+	fill(a, n, 1);
+	fill(b, n, 2);
+	std::cout << "n = " << n << " (|a| = " << a.size() << ", |b| = " << b.size() << ")" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	for (int op = 0; op < 3; ++op)
+	{
+		long double	sequential = 0;
+		size_t		expected = 0;
+
+		std::cout << names[op] << std::endl;
+		for (size_t i = 0; i < sizeof(threads) / sizeof(*threads); ++i)
+		{
+			size_t		result;
+			long double	ms = run(a, b, op, threads[i], result);
+
+			if (i == 0)
+			{
+				sequential = ms;
+				expected = result;
+			}
+			std::cout << "  " << std::setw(2) << threads[i] << " threads: " << std::setw(9) << ms << " ms  x"
+				<< std::setprecision(2) << sequential / ms << std::setprecision(1)
+				<< (result == expected ? "" : "  (size mismatch!)") << std::endl;
+		}
+	}
+	return (0);
+}
@@ -0,0 +1,143 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <stdlib.h>
+#include "chrono.hpp"
+#include <map.hpp>
+#include <sharded_map.hpp>
+
+/*
+** Throughput of ft::sharded_map against an ft::map behind one global
+** mutex, with every thread running a random mix of lookups and writes
+** (half inserts, half erases) over n keys, at 100/0, 95/5 and 50/50
+** read/write ratios.
+**
+** Usage: ./bench_sharded_map [threads] [shards] [n] (defaults 8 16 1000000)
+*/
+
+static const int	g_ops = 400000;
+
+struct locked_map
+{
+	std::mutex				lock;
+	ft::map<int, int>		map;
+
+	bool	get(int k, int &out)
+	{
+		std::lock_guard<std::mutex>	guard(lock);
+		ft::map<int, int>::iterator	it = map.find(k);
+
+		if (it == map.end())
+			return (false);
+		out = it->second;
+		return (true);
+	}
+
+	void	insert(int k, int v)
+	{
+		std::lock_guard<std::mutex>	guard(lock);
+
+		map.insert(ft::make_pair(k, v));
+	}
+
+	void	erase(int k)
+	{
+		std::lock_guard<std::mutex>	guard(lock);
+
+		map.erase(k);
+	}
+};
+
+struct sharded
+{
+	ft::sharded_map<int, int>	map;
+
+	explicit sharded(size_t shards) : map(shards) {}
+
+	bool	get(int k, int &out) { return (map.get(k, out)); }
+
+	void	insert(int k, int v) { map.insert(ft::make_pair(k, v)); }
+
+	void	erase(int k) { map.erase(k); }
+};
+
+/*
+** A small xorshift per thread: rand() takes a lock of its own.
+*/
+static unsigned	next_random(unsigned &state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return (state);
+}
+
+template <class Map>
+static void	worker(Map *m, int n, int write_percent, unsigned seed, long *hits)
+{
+	unsigned	state = seed;
+	int			value;
+
+	for (int i = 0; i < g_ops; ++i)
+	{
+		int	k = next_random(state) % n;
+
+		if (static_cast<int>(next_random(state) % 100) < write_percent)
+		{
+			if (next_random(state) & 1)
+				m->insert(k, i);
+			else
+				m->erase(k);
+		}
+		else if (m->get(k, value))
+			++*hits;
+	}
+}
+
+template <class Map>
+static double	run(Map &m, int threads, int n, int write_percent)
+{
+	std::vector<std::thread>	pool;
+	std::vector<long>			hits(threads);
+	long double					start = get_the_time();
+
+	for (int t = 0; t < threads; ++t)
+		pool.push_back(std::thread(worker<Map>, &m, n, write_percent, 2463534242u + t, &hits[t]));
+	for (int t = 0; t < threads; ++t)
+		pool[t].join();
+
+	long double	ms = get_the_time() - start;
+
+	return (static_cast<double>(threads) * g_ops / ms / 1000);
+}
+
+int	main(int argc, char **argv)
+{
+	const int	threads = argc > 1 ? atoi(argv[1]) : 8;
+	const int	shards = argc > 2 ? atoi(argv[2]) : 16;
+	const int	n = argc > 3 ? atoi(argv[3]) : 1000000;
+	const int	writes[] = { 0, 5, 50 };
+	locked_map	locked;
+	sharded		striped(shards);
+
+	for (int k = 0; k < n; k += 2)
+	{
+		locked.insert(k, k);
+		striped.insert(k, k);
+	}
+	std::cout << threads << " threads, " << shards << " shards, " << n << " keys, "
+		<< g_ops << " ops per thread (Mops/s)" << std::endl;
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(12) << "read/write" << std::setw(16) << "map + mutex" << std::setw(16) << "sharded_map" << std::endl;
+	for (int i = 0; i < 3; ++i)
+	{
+		double	a = run(locked, threads, n, writes[i]);
+		double	b = run(striped, threads, n, writes[i]);
+
+		std::cout << std::setw(9) << 100 - writes[i] << "/" << std::setw(2) << std::left << writes[i] << std::right
+			<< std::setw(16) << a << std::setw(16) << b << std::endl;
+	}
+	return (0);
+}
@@ -0,0 +1,85 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <unordered_map>
+#include <stdlib.h>
+#include "chrono.hpp"
+#include <map.hpp>
+#include <unordered_map.hpp>
+
+/*
+** ft::map against ft::unordered_map on int keys, with std::unordered_map
+** for reference: n random inserts, n lookups of present keys, n lookups
+** of absent ones, then erasing every key, in random order each time.
+**
+** Usage: ./bench_unordered_map [n] (default 1000000)
+*/
+
+struct std_map : public std::unordered_map<int, int>
+{
+	void	insert(const ft::pair<int, int> &p) { std::unordered_map<int, int>::insert(std::make_pair(p.first, p.second)); }
+
+	using std::unordered_map<int, int>::insert;
+};
+
+template <class Map>
+static void	run(const char *name, const std::vector<int> &keys, const std::vector<int> &hits, const std::vector<int> &misses)
+{
+	Map			m;
+	long		sum = 0;
+	long double	start = get_the_time();
+
+	for (size_t i = 0; i < keys.size(); ++i)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+
+	long double	insert = get_the_time() - start;
+
+	start = get_the_time();
+	for (size_t i = 0; i < hits.size(); ++i)
+		sum += m.find(hits[i])->second;
+
+	long double	hit = get_the_time() - start;
+
+	start = get_the_time();
+	for (size_t i = 0; i < misses.size(); ++i)
+		sum += (m.find(misses[i]) == m.end());
+
+	long double	miss = get_the_time() - start;
+
+	start = get_the_time();
+	for (size_t i = 0; i < hits.size(); ++i)
+		sum += m.erase(hits[i]);
+
+	long double	erase = get_the_time() - start;
+
+	std::cout << std::setw(20) << name
+		<< std::setw(12) << insert << std::setw(12) << hit << std::setw(12) << miss << std::setw(12) << erase
+		<< "   (" << sum << ")" << std::endl;
+}
+
+int	main(int argc, char **argv)
+{
+	const int			n = argc > 1 ? atoi(argv[1]) : 1000000;
+	std::vector<int>	keys;
+	std::vector<int>	hits;
+	std::vector<int>	misses;
+
+	srand(42);
+	for (int i = 0; i < n; ++i)
+	{
+		keys.push_back(2 * i);
+		misses.push_back(2 * i + 1);
+	}
+	std::random_shuffle(keys.begin(), keys.end());
+	std::random_shuffle(misses.begin(), misses.end());
+	hits = keys;
+	std::random_shuffle(hits.begin(), hits.end());
+	std::cout << "n = " << n << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << std::setw(20) << "" << std::setw(12) << "insert ms" << std::setw(12) << "hit ms"
+		<< std::setw(12) << "miss ms" << std::setw(12) << "erase ms" << std::endl;
+	run<ft::map<int, int> >("ft::map", keys, hits, misses);
+	run<ft::unordered_map<int, int> >("ft::unordered_map", keys, hits, misses);
+	run<std_map>("std::unordered_map", keys, hits, misses);
+	return (0);
+}
@@ -0,0 +1,113 @@
+#include <map>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <map.hpp>
+#include <set.hpp>
+#include "check.hpp"
+
+/*
+** aggregate(lo, hi) against a fold over std::map, through inserts and
+** erases, and its overloads: key_type for every comparator, any key for
+** transparent ones.
+*/
+
+struct sum_values
+{
+	typedef long	result_type;
+
+	static long	identity() { return (0); }
+	static long	lift(const ft::pair<const int, long> &v) { return (v.second); }
+	static long	combine(long a, long b) { return (a + b); }
+};
+
+struct concat_keys
+{
+	typedef std::string	result_type;
+
+	static std::string	identity() { return (""); }
+	static std::string	lift(const std::string &k) { return (k); }
+	static std::string	combine(const std::string &a, const std::string &b) { return (a + b); }
+};
+
+struct less_str
+{
+	typedef void	is_transparent;
+
+	bool	operator()(const std::string &a, const std::string &b) const { return (a < b); }
+	bool	operator()(const std::string &a, const char *b) const { return (a < b); }
+	bool	operator()(const char *a, const std::string &b) const { return (a < b); }
+	bool	operator()(const char *a, const char *b) const { return (std::strcmp(a, b) < 0); }
+};
+
+typedef ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int, long> >,
+	ft::rb_aggregate<sum_values> >	sum_map;
+
+static long	fold(const std::map<int, long> &ref, int lo, int hi)
+{
+	long	sum = 0;
+
+	for (std::map<int, long>::const_iterator it = ref.lower_bound(lo); it != ref.end() && it->first < hi; ++it)
+		sum += it->second;
+	return (sum);
+}
+
+static void	test_differential()
+{
+	sum_map				m;
+	std::map<int, long>	ref;
+
+	std::srand(42);
+	for (int round = 0; round < 20000; ++round)
+	{
+		int	k = std::rand() % 1000;
+
+		if (std::rand() % 3)
+		{
+			m.insert(ft::make_pair(k, static_cast<long>(k) * 3 - 500));
+			ref.insert(std::make_pair(k, static_cast<long>(k) * 3 - 500));
+		}
+		else
+		{
+			m.erase(k);
+			ref.erase(k);
+		}
+		if (round % 50 == 0)
+		{
+			int	lo = std::rand() % 1100 - 50;
+			int	hi = std::rand() % 1100 - 50;
+
+			CHECK(m.aggregate(lo, hi) == (lo < hi ? fold(ref, lo, hi) : 0));
+		}
+	}
+	CHECK(m.aggregate(-1, 1000) == fold(ref, -1, 1000));
+}
+
+static void	test_overloads()
+{
+	typedef ft::set<std::string, std::less<std::string>, std::allocator<std::string>,
+		ft::rb_aggregate<concat_keys> >	plain_set;
+	typedef ft::set<std::string, less_str, std::allocator<std::string>,
+		ft::rb_aggregate<concat_keys> >	transparent_set;
+
+	plain_set		plain;
+	transparent_set	transparent;
+	const char		*keys[] = { "a", "b", "c", "d", "e" };
+
+	for (size_t i = 0; i < sizeof(keys) / sizeof(*keys); ++i)
+	{
+		plain.insert(keys[i]);
+		transparent.insert(keys[i]);
+	}
+	CHECK(plain.aggregate(std::string("b"), "e") == "bcd");
+	CHECK(plain.aggregate("b", "e") == "bcd");
+	CHECK(transparent.aggregate("b", "e") == "bcd");
+	CHECK(transparent.aggregate(std::string("a"), std::string("c")) == "ab");
+}
+
+int	main()
+{
+	test_differential();
+	test_overloads();
+	return (check_result("aggregate"));
+}
@@ -0,0 +1,323 @@
+#include <map>
+#include <set>
+#include <cstdlib>
+#include <algorithm>
+#include <btree_map.hpp>
+#include <btree_set.hpp>
+#include "check.hpp"
+
+/*
+** btree_map and btree_set against std::map and std::set, then inserts
+** and erases whose copies throw part way, in trees deep enough for the
+** splits and merges to climb: the tree is left as it was and nothing
+** leaks.
+*/
+
+static int	key_of(const ft::pair<const int, fragile> &v) { return (v.first); }
+static int	key_of(const ft::pair<const fragile, int> &v) { return (v.first.key); }
+
+static bool	same_entry(const std::pair<const int, int> &a, const ft::pair<const int, int> &b)
+{
+	return (a.first == b.first && a.second == b.second);
+}
+
+template <class Map>
+static bool	same_keys(const Map &m, const std::map<int, int> &ref)
+{
+	std::map<int, int>::const_iterator	r = ref.begin();
+	size_t								n = 0;
+
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it, ++r, ++n)
+		if (r == ref.end() || key_of(*it) != r->first)
+			return (false);
+	return (r == ref.end() && n == m.size());
+}
+
+/*
+** Random inserts (hinted or not), erases by key, position and range, and
+** bound lookups; the whole content is compared, both ways, now and then.
+*/
+static void	test_differential()
+{
+	ft::btree_map<int, int>	m;
+	std::map<int, int>		ref;
+
+	std::srand(11);
+	for (int round = 0; round < 60000; ++round)
+	{
+		int	k = std::rand() % 4000;
+
+		switch (std::rand() % 6)
+		{
+			case 0:
+			case 1:
+				CHECK(m.insert(ft::make_pair(k, round)).second == ref.insert(std::make_pair(k, round)).second);
+				break ;
+			case 2:
+				m.insert(m.lower_bound(k), ft::make_pair(k, round));
+				ref.insert(std::make_pair(k, round));
+				break ;
+			case 3:
+				CHECK(m.erase(k) == ref.erase(k));
+				break ;
+			case 4:
+			{
+				ft::btree_map<int, int>::iterator	it = m.lower_bound(k);
+				std::map<int, int>::iterator		r = ref.lower_bound(k);
+
+				CHECK((it == m.end()) == (r == ref.end()));
+				if (it != m.end() && r != ref.end())
+				{
+					CHECK(it->first == r->first && it->second == r->second);
+					it = m.erase(it);
+					r = ref.erase(r);
+					CHECK((it == m.end()) == (r == ref.end()));
+					CHECK(it == m.end() || r == ref.end() || it->first == r->first);
+				}
+				break ;
+			}
+			default:
+			{
+				ft::btree_map<int, int>::iterator	up = m.upper_bound(k);
+				std::map<int, int>::iterator		r = ref.upper_bound(k);
+
+				CHECK((up == m.end()) == (r == ref.end()));
+				if (up != m.end() && r != ref.end())
+					CHECK(up->first == r->first);
+			}
+		}
+		if (round % 5000 == 4999)
+		{
+			std::map<int, int>::reverse_iterator	r = ref.rbegin();
+
+			CHECK(m.size() == ref.size());
+			CHECK(std::equal(ref.begin(), ref.end(), m.begin(), same_entry));
+			for (ft::btree_map<int, int>::reverse_iterator it = m.rbegin(); it != m.rend(); ++it, ++r)
+				CHECK(it->first == r->first);
+		}
+	}
+
+	int	lo = 1000;
+	int	hi = 3000;
+
+	m.erase(m.lower_bound(lo), m.lower_bound(hi));
+	ref.erase(ref.lower_bound(lo), ref.lower_bound(hi));
+	CHECK(m.size() == ref.size() && std::equal(ref.begin(), ref.end(), m.begin(), same_entry));
+	while (!ref.empty())
+	{
+		CHECK(m.erase(ref.begin()->first) == 1);
+		ref.erase(ref.begin());
+	}
+	CHECK(m.empty() && m.begin() == m.end());
+}
+
+/*
+** Sorted loads split unevenly: both directions must still give the right
+** content, and the set has the same engine under another key_of_value.
+*/
+static void	test_set_sorted_loads()
+{
+	ft::btree_set<int>	up;
+	ft::btree_set<int>	down;
+	std::set<int>		ref;
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		up.insert(up.end(), i);
+		down.insert(down.begin(), 20000 - 1 - i);
+		ref.insert(i);
+	}
+	CHECK(up.size() == 20000 && down.size() == 20000);
+	CHECK(std::equal(ref.begin(), ref.end(), up.begin()));
+	CHECK(std::equal(ref.begin(), ref.end(), down.begin()));
+	for (int i = 0; i < 20000; i += 2)
+	{
+		up.erase(i);
+		down.erase(down.find(i));
+		ref.erase(i);
+	}
+	CHECK(std::equal(ref.begin(), ref.end(), up.begin()));
+	CHECK(std::equal(ref.begin(), ref.end(), down.begin()));
+	CHECK(up.count(1) == 1 && up.count(2) == 0);
+	CHECK(*up.lower_bound(2) == 3 && up.upper_bound(19999) == up.end());
+}
+
+static void	test_insert_value_throws()
+{
+	for (int n = 40; n <= 4000; n *= 10)
+	{
+		for (int at = 1; at <= 3; ++at)
+		{
+			int	keys[] = { 1, 15, -1, n / 2 * 2 + 1, 2 * n + 1 };
+
+			for (size_t k = 0; k < sizeof(keys) / sizeof(*keys); ++k)
+			{
+				ft::btree_map<int, fragile>	m;
+				std::map<int, int>			ref;
+
+				for (int i = 0; i < n; ++i)
+				{
+					m.insert(ft::make_pair(2 * i, fragile(i)));
+					ref[2 * i] = i;
+				}
+
+				ft::pair<int, fragile>	v(keys[k], fragile(keys[k]));
+
+				fragile::countdown = at;
+				try
+				{
+					m.insert(v);
+				}
+				catch (const std::runtime_error &) {}
+				if (fragile::countdown == 0)
+					CHECK(same_keys(m, ref));
+				else
+					CHECK(m.size() == ref.size() + 1 && m.find(keys[k]) != m.end());
+				fragile::countdown = 0;
+				m.insert(v);
+				ref[keys[k]] = 0;
+				CHECK(same_keys(m, ref));
+			}
+		}
+	}
+}
+
+/*
+** With a fragile key the separators copied up by a split, and the one a
+** borrow copies on erase, throw as well.
+*/
+static void	test_key_throws()
+{
+	ft::btree_map<fragile, int>	m;
+	std::map<int, int>			ref;
+
+	for (int i = 0; i < 3000; ++i)
+	{
+		int	k = (i * 7919) % 3000;
+
+		fragile::countdown = 1 + i % 3;
+		try
+		{
+			m.insert(ft::make_pair(fragile(k), k));
+			ref[k] = k;
+		}
+		catch (const std::runtime_error &) {}
+		fragile::countdown = 0;
+		if (m.size() != ref.size())
+		{
+			m.insert(ft::make_pair(fragile(k), k));
+			ref[k] = k;
+		}
+	}
+	CHECK(same_keys(m, ref));
+	for (int i = 0; i < 3000; ++i)
+	{
+		int	k = (i * 7907) % 3000;
+
+		fragile::countdown = 1;
+		try
+		{
+			if (m.erase(fragile(k)))
+				ref.erase(k);
+		}
+		catch (const std::runtime_error &) {}
+		fragile::countdown = 0;
+		CHECK(m.size() == ref.size());
+		if (ref.count(k))
+		{
+			m.erase(fragile(k));
+			ref.erase(k);
+		}
+	}
+	CHECK(m.empty() && same_keys(m, ref));
+}
+
+/*
+** A copy that throws leaves the target as it was, and the source intact.
+*/
+static void	test_copy_throws()
+{
+	ft::btree_map<fragile, int>	src;
+	std::map<int, int>			ref_src;
+	std::map<int, int>			ref_dst;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		src.insert(ft::make_pair(fragile(i), i));
+		ref_src[i] = i;
+	}
+	for (int at = 1; at < 5000; at += 397)
+	{
+		ft::btree_map<fragile, int>	dst;
+
+		for (int i = 0; i < 50; ++i)
+		{
+			dst.insert(ft::make_pair(fragile(-i), i));
+			ref_dst[-i] = i;
+		}
+		fragile::countdown = at;
+		try
+		{
+			dst = src;
+			fragile::countdown = 0;
+			CHECK(same_keys(dst, ref_src));
+		}
+		catch (const std::runtime_error &)
+		{
+			fragile::countdown = 0;
+			CHECK(same_keys(dst, ref_dst));
+		}
+		fragile::countdown = at;
+		try
+		{
+			ft::btree_map<fragile, int>	copy(src);
+
+			fragile::countdown = 0;
+			CHECK(same_keys(copy, ref_src));
+		}
+		catch (const std::runtime_error &) {}
+		fragile::countdown = 0;
+	}
+	CHECK(same_keys(src, ref_src));
+}
+
+/*
+** The mapped value passed to try_emplace() or insert_or_assign() may live
+** in the leaf that has to shift or split to take the new key.
+*/
+static void	test_aliasing()
+{
+	for (int n = 2; n <= 2000; n *= 3)
+	{
+		ft::btree_map<int, std::string>	m;
+
+		for (int i = 0; i < n; ++i)
+			m[2 * i] = std::string(40, 'a' + i % 26);
+		for (int i = 0; i + 1 < n; ++i)
+		{
+			std::string	expect = m.at(2 * i + 2);
+
+			CHECK(m.try_emplace(2 * i + 1, m.at(2 * i + 2)).second);
+			CHECK(m.at(2 * i + 1) == expect);
+		}
+		for (int i = 0; i < n; ++i)
+		{
+			std::string	expect = m.at(i);
+
+			CHECK(m.insert_or_assign(-1 - i, m.at(i)).second);
+			CHECK(m.at(-1 - i) == expect);
+		}
+		CHECK(m.size() == static_cast<size_t>(3 * n - 1));
+	}
+}
+
+int	main()
+{
+	test_differential();
+	test_set_sorted_loads();
+	test_insert_value_throws();
+	test_key_throws();
+	test_copy_throws();
+	test_aliasing();
+	return (check_result("btree_map"));
+}
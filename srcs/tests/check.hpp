@@ -0,0 +1,67 @@
+#ifndef CHECK_H
+# define CHECK_H
+
+# include <iostream>
+# include <string>
+# include <stdexcept>
+# include <atomic>
+
+/*
+** What the tests share: CHECK() reports a failed condition and counts it,
+** and check_result() turns the count into the exit status.
+*/
+
+static int	g_failures = 0;
+
+# define CHECK(cond) \
+	do { \
+		if (!(cond)) \
+		{ \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond ") failed" << std::endl; \
+			++g_failures; \
+		} \
+	} while (0)
+
+static inline int	check_result(const char *name)
+{
+	if (g_failures)
+		std::cerr << name << ": " << g_failures << " failed" << std::endl;
+	else
+		std::cout << name << ": ok" << std::endl;
+	return (g_failures != 0);
+}
+
+/*
+** A key whose copy throws once countdown reaches zero; it holds a string
+** so that a leaked copy shows up under the leak checker. The countdown
+** may be hit from several threads.
+*/
+struct fragile
+{
+	static std::atomic<int>	countdown;
+
+	int			key;
+	std::string	payload;
+
+	fragile(int key = 0) : key(key), payload(48, 'x') {}
+
+	fragile(const fragile &other) : key(other.key), payload(other.payload)
+	{
+		if (countdown.load() > 0 && --countdown == 0)
+			throw std::runtime_error("fragile copy");
+	}
+
+	fragile	&operator=(const fragile &other)
+	{
+		key = other.key;
+		payload = other.payload;
+		return (*this);
+	}
+
+	bool	operator<(const fragile &other) const { return (key < other.key); }
+	bool	operator==(const fragile &other) const { return (key == other.key); }
+};
+
+std::atomic<int>	fragile::countdown(0);
+
+#endif
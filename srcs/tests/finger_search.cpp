@@ -0,0 +1,230 @@
+#include <map>
+#include <set>
+#include <vector>
+#include <cstdlib>
+#include <functional>
+#include <map.hpp>
+#include <set.hpp>
+#include "check.hpp"
+
+/*
+** Finger mode and find(hint, key) on map and set, against std::map: every
+** lookup from every starting node of small trees, walks of nearby keys and
+** jumps between updates, and every change that can take the finger's node
+** away (erase, extract, clear, copies, swaps, merges and set operations).
+*/
+
+/*
+** Each key present or absent (the odd ones, and past both ends), looked
+** up from each node of the tree and from end(): by find(hint, key), and
+** in finger mode after a lookup that leaves the finger on that node.
+*/
+template <class Compare>
+static void	test_every_start()
+{
+	for (int n = 0; n <= 40; ++n)
+	{
+		ft::map<int, int, Compare>	m;
+		std::map<int, int, Compare>	ref;
+
+		for (int i = 0; i < n; ++i)
+		{
+			m.insert(ft::make_pair(2 * i, i));
+			ref.insert(std::make_pair(2 * i, i));
+		}
+		m.finger_search(true);
+
+		std::vector<typename ft::map<int, int, Compare>::const_iterator>	hints;
+
+		for (typename ft::map<int, int, Compare>::const_iterator it = m.begin(); it != m.end(); ++it)
+			hints.push_back(it);
+		hints.push_back(m.end());
+		for (size_t h = 0; h < hints.size(); ++h)
+		{
+			for (int k = -2; k <= 2 * n + 1; ++k)
+			{
+				typename ft::map<int, int, Compare>::const_iterator	found = m.find(hints[h], k);
+
+				CHECK((found == m.end()) == !ref.count(k));
+				CHECK(found == m.end() || (found->first == k && found->second == k / 2));
+				if (hints[h] != m.end())
+					m.find(hints[h]->first);
+				else
+					m.find(-3);
+				found = m.find(k);
+				CHECK((found == m.end()) == !ref.count(k));
+				CHECK(found == m.end() || found->first == k);
+			}
+		}
+	}
+}
+
+/*
+** Runs of lookups close to one another, random jumps, and updates in
+** between, with a copy of the map checked in plain mode.
+*/
+static void	test_walks()
+{
+	ft::map<int, int>	m;
+	ft::map<int, int>	plain;
+	std::map<int, int>	ref;
+	int					at = 0;
+
+	m.finger_search(true);
+	std::srand(23);
+	for (int round = 0; round < 200000; ++round)
+	{
+		int	k = std::rand() % 4000;
+
+		switch (std::rand() % 8)
+		{
+			case 0:
+				m[k] = round;
+				plain[k] = round;
+				ref[k] = round;
+				break ;
+			case 1:
+				CHECK(m.erase(k) == ref.erase(k));
+				plain.erase(k);
+				break ;
+			case 2:
+				at = k;
+				break ;
+			default:
+			{
+				at += std::rand() % 7 - 3;
+
+				ft::map<int, int>::iterator	it = m.find(at);
+
+				CHECK((it == m.end()) == !ref.count(at));
+				CHECK(it == m.end() || it->second == ref[at]);
+				CHECK(m.count(at) == ref.count(at));
+				CHECK(plain.find(at) == plain.end() || plain.find(at)->second == ref[at]);
+			}
+		}
+	}
+	CHECK(m.finger_search() && !plain.finger_search());
+	CHECK(m.size() == ref.size() && m == plain);
+}
+
+/*
+** The finger is left on a node that then goes away; the next lookup must
+** not start from it.
+*/
+static void	test_finger_invalidation()
+{
+	typedef ft::map<int, int>	map;
+
+	map					m;
+	std::map<int, int>	ref;
+
+	m.finger_search(true);
+	for (int i = 0; i < 2000; ++i)
+	{
+		m[i] = i;
+		ref[i] = i;
+	}
+	for (int i = 0; i < 2000; i += 3)
+	{
+		CHECK(m.find(i) != m.end());
+		m.erase(i);
+		ref.erase(i);
+		CHECK(m.find(i + 1) != m.end() && m.find(i) == m.end());
+	}
+	for (int i = 1; i < 2000; i += 3)
+	{
+		m.find(i);
+
+		map::node_type	handle = m.extract(i);
+
+		CHECK(!handle.empty() && m.find(i) == m.end());
+		ref.erase(i);
+	}
+	m.find(500);
+	m.erase(m.lower_bound(400), m.lower_bound(600));
+	ref.erase(ref.lower_bound(400), ref.lower_bound(600));
+	for (int i = 0; i < 2000; ++i)
+		CHECK((m.find(i) == m.end()) == !ref.count(i));
+
+	map	copy(m);
+	map	other;
+
+	CHECK(copy.finger_search());
+	copy.find(800);
+	m.find(1000);
+	m.swap(copy);
+	copy.clear();
+	CHECK(m.find(1001) == m.end() || m.find(1001)->first == 1001);
+	other[1001] = -1;
+	other[3000] = -1;
+	other.find(3000);
+	m.merge(other);
+	CHECK(other.size() == 1 && m.find(3000) != m.end() && other.find(3000) == other.end());
+	m.find(1500);
+	m = other;
+	CHECK(!m.finger_search());
+	m.finger_search(true);
+	CHECK(m.size() == 1 && m.find(1500) == m.end() && m.find(1001) != m.end());
+	m.clear();
+	CHECK(m.find(1001) == m.end());
+
+	ft::set<int>	s;
+	ft::set<int>	t;
+	std::set<int>	ref_s;
+	std::set<int>	ref_t;
+
+	s.finger_search(true);
+	for (int i = 0; i < 20000; ++i)
+	{
+		s.insert(2 * i);
+		t.insert(3 * i);
+		ref_s.insert(2 * i);
+		ref_t.insert(3 * i);
+	}
+	for (int round = 0; round < 6; ++round)
+	{
+		s.find(std::rand() % 40000);
+		if (round % 3 == 0)
+		{
+			s.set_union(t, 4);
+			ref_s.insert(ref_t.begin(), ref_t.end());
+		}
+		else if (round % 3 == 1)
+		{
+			s.set_intersection(t, 4);
+			for (std::set<int>::iterator it = ref_s.begin(); it != ref_s.end();)
+				it = ref_t.count(*it) ? ++it : ref_s.erase(it);
+		}
+		else
+		{
+			s.set_difference(t);
+			for (std::set<int>::iterator it = ref_t.begin(); it != ref_t.end(); ++it)
+				ref_s.erase(*it);
+		}
+		CHECK(s.size() == ref_s.size());
+		for (int i = 0; i < 2000; ++i)
+		{
+			int	k = std::rand() % 60000;
+
+			CHECK((s.find(k) == s.end()) == !ref_s.count(k));
+		}
+		t.clear();
+		ref_t.clear();
+		for (int i = 0; i < 20000; ++i)
+		{
+			int	k = std::rand() % 60000;
+
+			t.insert(k);
+			ref_t.insert(k);
+		}
+	}
+}
+
+int	main()
+{
+	test_every_start<std::less<int> >();
+	test_every_start<std::greater<int> >();
+	test_walks();
+	test_finger_invalidation();
+	return (check_result("finger_search"));
+}
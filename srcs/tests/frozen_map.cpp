@@ -0,0 +1,121 @@
+#include <set>
+#include <map.hpp>
+#include <set.hpp>
+#include <frozen_map.hpp>
+#include <frozen_set.hpp>
+#include "check.hpp"
+
+/*
+** frozen_set and frozen_map against std::set: the keys ez_simd handles
+** take the wide descent over the top 16 KB of the array, a comparator it
+** does not know takes the scalar one all the way, and both must give
+** the same bounds. Sizes go around the 16 KB mark and around the ends
+** of the four-level steps.
+*/
+
+template <class T>
+struct plain_less
+{
+	bool	operator()(const T &a, const T &b) const { return (a < b); }
+};
+
+/*
+** Keys spaced by step, so that every other query misses.
+*/
+template <class T>
+static T	key_at(size_t i, T base, T step)
+{
+	return (static_cast<T>(base + static_cast<T>(i) * step));
+}
+
+template <class Set>
+static bool	same_bound(const Set &s, typename Set::const_iterator it, const std::set<typename Set::key_type> &ref,
+	typename std::set<typename Set::key_type>::const_iterator r)
+{
+	if (it == s.end() || r == ref.end())
+		return ((it == s.end()) == (r == ref.end()));
+	return (*it == *r);
+}
+
+template <class T>
+static void	test_bounds(size_t n, T base, T step)
+{
+	ft::set<T>								wide_src;
+	ft::set<T, plain_less<T> >				scalar_src;
+	std::set<T>								ref;
+
+	for (size_t i = 0; i < n; ++i)
+	{
+		T	k = key_at(2 * i, base, step);
+
+		wide_src.insert(k);
+		scalar_src.insert(k);
+		ref.insert(k);
+	}
+
+	const ft::frozen_set<T>					wide(wide_src);
+	const ft::frozen_set<T, plain_less<T> >	scalar(scalar_src);
+
+	CHECK(wide.size() == n && scalar.size() == n);
+	for (size_t i = 0; i <= 2 * n + 1; ++i)
+	{
+		T	k = key_at(i, base, step);
+
+		if (i == 2 * n + 1)
+			k = key_at(0, base, step) - step;
+		CHECK(same_bound(wide, wide.lower_bound(k), ref, ref.lower_bound(k)));
+		CHECK(same_bound(wide, wide.upper_bound(k), ref, ref.upper_bound(k)));
+		CHECK(same_bound(scalar, scalar.lower_bound(k), ref, ref.lower_bound(k)));
+		CHECK(same_bound(scalar, scalar.upper_bound(k), ref, ref.upper_bound(k)));
+		CHECK(wide.count(k) == ref.count(k) && scalar.count(k) == ref.count(k));
+	}
+}
+
+template <class T>
+static void	test_sizes(T base, T step)
+{
+	const size_t	wide_slots = 16384 / sizeof(T);
+	const size_t	sizes[] = { 0, 1, 2, 14, 15, 16, 17, 254, 255, 256, 271, 272 };
+	const int		around[] = { -17, -16, -15, -1, 0, 1, 15, 16, 17 };
+
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); ++i)
+		test_bounds<T>(sizes[i], base, step);
+	for (size_t i = 0; i < sizeof(around) / sizeof(*around); ++i)
+		test_bounds<T>(wide_slots + around[i], base, step);
+	test_bounds<T>(4 * wide_slots + 3, base, step);
+}
+
+static void	test_map()
+{
+	ft::map<int, int>	src;
+
+	for (int i = 0; i < 5000; ++i)
+		src.insert(ft::make_pair(3 * i - 7000, i));
+
+	const ft::frozen_map<int, int>	m(src);
+
+	CHECK(m.size() == src.size());
+	CHECK(std::equal(src.begin(), src.end(), m.begin()));
+	for (int k = -7010; k < 8010; ++k)
+	{
+		ft::map<int, int>::const_iterator			r = src.lower_bound(k);
+		ft::frozen_map<int, int>::const_iterator	it = m.lower_bound(k);
+
+		CHECK((r == src.end()) == (it == m.end()));
+		if (r != src.end() && it != m.end())
+			CHECK(r->first == it->first && r->second == it->second);
+		CHECK(m.count(k) == src.count(k));
+	}
+	CHECK(m.at(-7000) == 0 && m.find(-6999) == m.end());
+}
+
+int	main()
+{
+	test_sizes<int>(-100000, 3);
+	test_sizes<unsigned int>(0x7ffff000u, 5);
+	test_sizes<long>(-5000000000L, 7);
+	test_sizes<float>(-1000.f, 0.25f);
+	test_sizes<double>(-1e12, 1.5);
+	test_map();
+	return (check_result("frozen_map"));
+}
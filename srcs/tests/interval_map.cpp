@@ -0,0 +1,52 @@
+#include <vector>
+#include <iterator>
+#include <interval_map.hpp>
+#include "check.hpp"
+
+/*
+** Intervals holding no point are turned down by every insert, and so never
+** show up in a query.
+*/
+
+typedef ft::interval_map<int, int>	imap;
+
+static void	test_reject_empty()
+{
+	imap	m;
+
+	CHECK(m.insert(3, 7, 0).second);
+	CHECK(!m.insert(5, 5, 1).second);
+	CHECK(m.insert(5, 5, 1).first == m.end());
+	CHECK(!m.insert(9, 2, 2).second);
+	CHECK(!m.insert(imap::value_type(imap::key_type(4, 4), 3)).second);
+	CHECK(m.size() == 1);
+
+	std::vector<imap::value_type>	src;
+
+	src.push_back(imap::value_type(imap::key_type(0, 10), 4));
+	src.push_back(imap::value_type(imap::key_type(6, 6), 5));
+	src.push_back(imap::value_type(imap::key_type(8, 1), 6));
+	src.push_back(imap::value_type(imap::key_type(1, 2), 7));
+	m.insert(src.begin(), src.end());
+	CHECK(m.size() == 3);
+
+	imap	built(src.begin(), src.end());
+
+	CHECK(built.size() == 2);
+
+	std::vector<imap::iterator>	found;
+
+	m.overlapping(0, 100, std::back_inserter(found));
+	CHECK(found.size() == 3);
+	for (size_t i = 0; i < found.size(); ++i)
+		CHECK(found[i]->first.first < found[i]->first.second);
+	found.clear();
+	m.stabbing(6, std::back_inserter(found));
+	CHECK(found.size() == 2);
+}
+
+int	main()
+{
+	test_reject_empty();
+	return (check_result("interval_map"));
+}
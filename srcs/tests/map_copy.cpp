@@ -0,0 +1,74 @@
+#include <map.hpp>
+#include <set.hpp>
+#include "check.hpp"
+
+/*
+** Copying a tree whose values throw part way: the target ends up empty and
+** still usable, and nothing leaks.
+*/
+
+template <class Tree>
+static size_t	walk(const Tree &t)
+{
+	size_t	n = 0;
+
+	for (typename Tree::const_iterator it = t.begin(); it != t.end(); ++it)
+		++n;
+	return (n);
+}
+
+static void	test_assign()
+{
+	ft::map<int, fragile>	src;
+	ft::map<int, fragile>	dst;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		src.insert(ft::make_pair(i, fragile(i)));
+		dst.insert(ft::make_pair(1000 + i, fragile(i)));
+	}
+	fragile::countdown = 50;
+	try
+	{
+		dst = src;
+		CHECK(!"operator= did not throw");
+	}
+	catch (const std::runtime_error &) {}
+	fragile::countdown = 0;
+	CHECK(dst.empty());
+	CHECK(dst.size() == walk(dst));
+	CHECK(dst.begin() == dst.end());
+	dst.insert(ft::make_pair(7, fragile(7)));
+	CHECK(dst.size() == 1 && walk(dst) == 1);
+	dst = src;
+	CHECK(dst.size() == 100 && walk(dst) == 100);
+	CHECK(dst == src);
+}
+
+static void	test_copy_ctor()
+{
+	ft::set<fragile>	src;
+
+	for (int i = 0; i < 100; ++i)
+		src.insert(fragile(i));
+	for (int at = 1; at <= 100; at += 33)
+	{
+		fragile::countdown = at;
+		try
+		{
+			ft::set<fragile>	dst(src);
+
+			CHECK(!"copy constructor did not throw");
+		}
+		catch (const std::runtime_error &) {}
+	}
+	fragile::countdown = 0;
+	CHECK(src.size() == 100 && walk(src) == 100);
+}
+
+int	main()
+{
+	test_assign();
+	test_copy_ctor();
+	return (check_result("map_copy"));
+}
@@ -0,0 +1,286 @@
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+#include <map.hpp>
+#include <set.hpp>
+#include "check.hpp"
+
+/*
+** extract(), insert() of a node handle and merge() on map and set, against
+** std::map: nodes move between trees without a copy, a handle refused for
+** a taken key keeps its node, merge() leaves the duplicates in the source,
+** handles outlive the tree they came from, and the counts kept by an
+** augmented tree follow the nodes around.
+*/
+
+typedef ft::map<int, fragile>	fmap;
+typedef ft::set<int, std::less<int>, std::allocator<int>, ft::rb_subtree_size>	oset;
+
+template <class Map>
+static bool	same_keys(const Map &m, const std::map<int, int> &ref)
+{
+	std::map<int, int>::const_iterator	r = ref.begin();
+	size_t								n = 0;
+
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it, ++r, ++n)
+		if (r == ref.end() || it->first != r->first || it->second.key != r->second)
+			return (false);
+	return (r == ref.end() && n == m.size());
+}
+
+/*
+** Random moves between two maps, by key or by position, with or without
+** a hint; fragile throws on the first copy, so none may happen.
+*/
+static void	test_differential()
+{
+	fmap				m[2];
+	std::map<int, int>	ref[2];
+
+	std::srand(21);
+	for (int i = 0; i < 4000; ++i)
+	{
+		int	k = std::rand() % 3000;
+		int	side = std::rand() % 2;
+
+		m[side].insert(ft::make_pair(k, fragile(i)));
+		ref[side].insert(std::make_pair(k, i));
+	}
+	fragile::countdown = 1;
+	for (int round = 0; round < 40000; ++round)
+	{
+		int	k = std::rand() % 3000;
+		int	from = std::rand() % 2;
+		int	to = 1 - from;
+
+		fmap::node_type	handle;
+
+		if (std::rand() % 2)
+			handle = m[from].extract(k);
+		else
+		{
+			fmap::iterator	it = m[from].lower_bound(k);
+
+			if (it != m[from].end())
+			{
+				k = it->first;
+				handle = m[from].extract(it);
+			}
+		}
+		CHECK(handle.empty() == !ref[from].count(k));
+		if (handle.empty())
+			continue ;
+		CHECK(handle.value().first == k && handle.value().second.key == ref[from][k]);
+		CHECK(m[from].count(k) == 0);
+
+		const fragile	*addr = &handle.value().second;
+
+		if (std::rand() % 2)
+		{
+			fmap::insert_return_type	ret = m[to].insert(handle);
+
+			CHECK(ret.inserted == !ref[to].count(k));
+			CHECK(ret.position != m[to].end() && ret.position->first == k);
+			CHECK(handle.empty());
+			if (ret.inserted)
+				CHECK(&ret.position->second == addr);
+			else
+			{
+				CHECK(!ret.node.empty() && &ret.node.value().second == addr);
+				handle = ret.node;
+			}
+		}
+		else
+		{
+			fmap::iterator	it = m[to].insert(m[to].upper_bound(k), handle);
+
+			CHECK(it != m[to].end() && it->first == k);
+			CHECK(handle.empty() == !ref[to].count(k));
+		}
+		if (handle.empty())
+		{
+			ref[to][k] = ref[from][k];
+			ref[from].erase(k);
+		}
+		else
+			CHECK(m[from].insert(handle).inserted);
+		CHECK(m[from].size() == ref[from].size() && m[to].size() == ref[to].size());
+	}
+	CHECK(fragile::countdown == 1);
+	fragile::countdown = 0;
+	CHECK(same_keys(m[0], ref[0]) && same_keys(m[1], ref[1]));
+}
+
+/*
+** Whatever of the source has a key already in the target stays in the
+** source, untouched; the rest moves over without a copy, and stays valid
+** once the source is gone.
+*/
+static void	test_merge()
+{
+	for (int range = 10; range <= 10000; range *= 10)
+	{
+		fmap				dst;
+		fmap				*src = new fmap;
+		std::map<int, int>	ref_dst;
+		std::map<int, int>	ref_src;
+
+		for (int i = 0; i < 3000; ++i)
+		{
+			int	k = std::rand() % range;
+
+			if (dst.insert(ft::make_pair(k, fragile(i))).second)
+				ref_dst[k] = i;
+			k = std::rand() % range;
+			if (src->insert(ft::make_pair(k, fragile(-i))).second)
+				ref_src[k] = -i;
+		}
+
+		std::map<int, int>	left;
+
+		for (std::map<int, int>::iterator it = ref_src.begin(); it != ref_src.end(); ++it)
+			if (!ref_dst.insert(*it).second)
+				left.insert(*it);
+		fragile::countdown = 1;
+		dst.merge(*src);
+		CHECK(fragile::countdown == 1);
+		fragile::countdown = 0;
+		CHECK(same_keys(dst, ref_dst) && same_keys(*src, left));
+		delete src;
+
+		fmap	empty;
+
+		dst.merge(dst);
+		empty.merge(dst);
+		CHECK(dst.empty() && same_keys(empty, ref_dst));
+	}
+}
+
+static void	test_empty_handles()
+{
+	fmap	m;
+
+	m.insert(ft::make_pair(1, fragile(1)));
+
+	fmap::node_type	none = m.extract(2);
+
+	CHECK(none.empty() && !none);
+	CHECK(m.size() == 1);
+
+	fmap::insert_return_type	ret = m.insert(none);
+
+	CHECK(!ret.inserted && ret.position == m.end() && ret.node.empty());
+	CHECK(m.insert(m.begin(), none) == m.end() && m.size() == 1);
+
+	fmap::node_type	one = m.extract(m.begin());
+
+	CHECK(!one.empty() && one && m.empty() && m.begin() == m.end());
+	none.swap(one);
+	CHECK(one.empty() && none.value().first == 1);
+
+	fmap::node_type	moved(none);
+
+	CHECK(none.empty() && moved.value().second.key == 1);
+}
+
+/*
+** A handle keeps the memory of its node alive after the tree is gone, and
+** trees that took nodes from another can free and reuse their slots.
+*/
+static void	test_outliving_source()
+{
+	fmap				dst;
+	std::map<int, int>	ref;
+	fmap				*src = new fmap;
+
+	for (int i = 0; i < 5000; ++i)
+		src->insert(ft::make_pair(i, fragile(i)));
+	for (int i = 0; i < 5000; i += 2)
+	{
+		fmap::node_type	handle = src->extract(i);
+
+		dst.insert(handle);
+		ref[i] = i;
+	}
+
+	fmap::node_type	kept = src->extract(1);
+
+	delete src;
+	CHECK(kept.value().first == 1 && kept.value().second.key == 1);
+	CHECK(same_keys(dst, ref));
+	for (int i = 0; i < 5000; i += 4)
+	{
+		dst.erase(i);
+		ref.erase(i);
+	}
+	for (int i = 0; i < 2000; ++i)
+	{
+		dst.insert(ft::make_pair(10000 + i, fragile(i)));
+		ref[10000 + i] = i;
+	}
+	CHECK(dst.insert(kept).inserted);
+	ref[1] = 1;
+	CHECK(same_keys(dst, ref));
+}
+
+/*
+** A set's key may change while the node is out, and the subtree sizes of
+** an augmented set follow extract(), insert() and merge().
+*/
+static void	test_set()
+{
+	ft::set<std::string>	s;
+	ft::set<std::string>	t;
+
+	s.insert("b");
+	s.insert("a");
+
+	ft::set<std::string>::node_type	handle = s.extract(s.begin());
+
+	handle.value() = "zz";
+	CHECK(t.insert(handle).inserted && *t.begin() == "zz" && s.size() == 1);
+
+	oset				o;
+	oset				p;
+	std::set<int>		ref;
+	std::vector<int>	sorted;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		o.insert(3 * i);
+		p.insert(2 * i);
+		ref.insert(3 * i);
+	}
+	for (int i = 0; i < 6000; i += 5)
+	{
+		oset::node_type	h = p.extract(i);
+
+		if (!h.empty() && o.insert(h).inserted)
+			ref.insert(i);
+	}
+	o.merge(p);
+	for (oset::iterator it = p.begin(); it != p.end(); ++it)
+		CHECK(o.count(*it) == 1);
+	for (int i = 0; i < 4000; i += 2)
+		ref.insert(i);
+	sorted.assign(ref.begin(), ref.end());
+	CHECK(o.size() == sorted.size());
+	for (size_t i = 0; i < sorted.size(); i += 7)
+	{
+		CHECK(*o.nth(i) == sorted[i]);
+		CHECK(o.rank(sorted[i]) == i);
+	}
+}
+
+int	main()
+{
+	test_differential();
+	test_merge();
+	test_empty_handles();
+	test_outliving_source();
+	test_set();
+	return (check_result("node_handle"));
+}
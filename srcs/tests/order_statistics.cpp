@@ -0,0 +1,154 @@
+#include <set>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+#include <iterator>
+#include <map.hpp>
+#include <set.hpp>
+#include "check.hpp"
+
+/*
+** nth(), rank() and count_range() under the rb_subtree_size augmentation,
+** against a sorted std::vector, through every way the tree changes shape:
+** single and hinted inserts, erases by key and by range, copies, swaps
+** and the set operations.
+*/
+
+typedef ft::set<int, std::less<int>, std::allocator<int>, ft::rb_subtree_size>	oset;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+	ft::rb_subtree_size>														omap;
+
+static bool	check_stats(const oset &s, const std::set<int> &ref)
+{
+	std::vector<int>	sorted(ref.begin(), ref.end());
+	bool				ok = (s.size() == sorted.size());
+
+	for (size_t i = 0; ok && i < sorted.size(); ++i)
+		ok = (*s.nth(i) == sorted[i]);
+	ok = ok && s.nth(sorted.size()) == s.end();
+	for (int k = -5; ok && k < 2100; k += 7)
+	{
+		size_t	below = std::lower_bound(sorted.begin(), sorted.end(), k) - sorted.begin();
+		size_t	upto = std::lower_bound(sorted.begin(), sorted.end(), k + 50) - sorted.begin();
+
+		ok = (s.rank(k) == below && s.count_range(k, k + 50) == upto - below
+			&& s.count_range(k + 50, k) == 0 && s.count_range(k, k) == 0);
+	}
+	return (ok);
+}
+
+static void	test_updates()
+{
+	oset			s;
+	std::set<int>	ref;
+
+	std::srand(9);
+	for (int round = 0; round < 20000; ++round)
+	{
+		int	k = std::rand() % 2000;
+
+		switch (std::rand() % 4)
+		{
+			case 0:
+				s.insert(k);
+				ref.insert(k);
+				break ;
+			case 1:
+				s.insert(s.lower_bound(k), k);
+				ref.insert(k);
+				break ;
+			case 2:
+				s.erase(k);
+				ref.erase(k);
+				break ;
+			default:
+				if (!ref.empty())
+				{
+					oset::iterator	it = s.nth(std::rand() % s.size());
+
+					CHECK(it != s.end());
+					if (it == s.end())
+						return ;
+					ref.erase(*it);
+					s.erase(it);
+				}
+		}
+		if (round % 2500 == 0)
+			CHECK(check_stats(s, ref));
+	}
+	CHECK(check_stats(s, ref));
+	s.erase(s.lower_bound(500), s.lower_bound(1500));
+	ref.erase(ref.lower_bound(500), ref.lower_bound(1500));
+	CHECK(check_stats(s, ref));
+
+	oset	copy(s);
+	oset	other;
+
+	other.insert(7);
+	other.swap(copy);
+	CHECK(check_stats(other, ref));
+	CHECK(copy.size() == 1 && copy.rank(8) == 1 && *copy.nth(0) == 7);
+	s.clear();
+	CHECK(check_stats(s, std::set<int>()));
+}
+
+static void	test_set_operations()
+{
+	oset			a;
+	oset			b;
+	std::set<int>	ra;
+	std::set<int>	rb;
+
+	for (int k = 0; k < 2000; ++k)
+	{
+		if (k % 3 == 0)
+		{
+			a.insert(k);
+			ra.insert(k);
+		}
+		if (k % 5 == 0)
+		{
+			b.insert(k);
+			rb.insert(k);
+		}
+	}
+
+	oset			u(a);
+	oset			i(a);
+	oset			d(a);
+	std::set<int>	ru(ra);
+	std::set<int>	ri;
+	std::set<int>	rd;
+
+	ru.insert(rb.begin(), rb.end());
+	std::set_intersection(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(ri, ri.end()));
+	std::set_difference(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(rd, rd.end()));
+	u.set_union(b);
+	i.set_intersection(b);
+	d.set_difference(b, 4);
+	CHECK(check_stats(u, ru));
+	CHECK(check_stats(i, ri));
+	CHECK(check_stats(d, rd));
+}
+
+static void	test_map()
+{
+	omap	m;
+
+	for (int k = 0; k < 1000; ++k)
+		m.insert(ft::make_pair(3 * k, k));
+	for (int k = 0; k < 1000; k += 2)
+		m.erase(3 * k);
+	for (size_t n = 0; n < m.size(); ++n)
+		CHECK(m.nth(n)->second == static_cast<int>(2 * n + 1));
+	CHECK(m.rank(3) == 0 && m.rank(4) == 1 && m.rank(3000) == 500);
+	CHECK(m.count_range(0, 3000) == 500 && m.count_range(3, 10) == 2);
+}
+
+int	main()
+{
+	test_updates();
+	test_set_operations();
+	test_map();
+	return (check_result("order_statistics"));
+}
@@ -0,0 +1,186 @@
+#include <map>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <persistent_map.hpp>
+#include "check.hpp"
+
+/*
+** persistent_map against std::map, with snapshots taken along the way
+** that must keep the content they had, then updates whose copies throw
+** part way through the path: the version is left as it was, the
+** snapshots taken before are untouched, and nothing leaks.
+*/
+
+typedef ft::persistent_map<int, fragile>	pmap;
+
+static bool	same_keys(const pmap &m, const std::map<int, int> &ref)
+{
+	std::map<int, int>::const_iterator	r = ref.begin();
+
+	for (pmap::const_iterator it = m.begin(); it != m.end(); ++it, ++r)
+		if (r == ref.end() || it->first != r->first)
+			return (false);
+	return (r == ref.end() && m.size() == ref.size());
+}
+
+typedef ft::persistent_map<int, int>	imap;
+
+static bool	same_content(const imap &m, const std::map<int, int> &ref)
+{
+	std::map<int, int>::const_iterator	r = ref.begin();
+
+	for (imap::const_iterator it = m.begin(); it != m.end(); ++it, ++r)
+		if (r == ref.end() || it->first != r->first || it->second != r->second)
+			return (false);
+	return (r == ref.end() && m.size() == ref.size());
+}
+
+static void	test_differential()
+{
+	imap							m;
+	std::map<int, int>				ref;
+	std::vector<imap>				snapshots;
+	std::vector<std::map<int, int> >	refs;
+
+	std::srand(3);
+	for (int round = 0; round < 40000; ++round)
+	{
+		int	k = std::rand() % 3000;
+
+		switch (std::rand() % 4)
+		{
+			case 0:
+				CHECK(m.insert(ft::make_pair(k, round)).second == ref.insert(std::make_pair(k, round)).second);
+				break ;
+			case 1:
+				CHECK(m.insert_or_assign(k, round).second == !ref.count(k));
+				ref[k] = round;
+				break ;
+			case 2:
+				CHECK(m.erase(k) == ref.erase(k));
+				break ;
+			default:
+				CHECK(m.count(k) == ref.count(k));
+				if (ref.count(k))
+					CHECK(m.at(k) == ref[k]);
+		}
+		if (round % 2000 == 0)
+		{
+			snapshots.push_back(m.snapshot());
+			refs.push_back(ref);
+		}
+	}
+	CHECK(same_content(m, ref));
+	for (size_t i = 0; i < snapshots.size(); ++i)
+		CHECK(same_content(snapshots[i], refs[i]));
+
+	std::map<int, int>::const_reverse_iterator	r = ref.rbegin();
+
+	for (imap::const_reverse_iterator it = m.rbegin(); it != m.rend(); ++it, ++r)
+		CHECK(r != ref.rend() && it->first == r->first);
+	m.clear();
+	CHECK(m.empty() && m.begin() == m.end());
+	CHECK(same_content(snapshots.back(), refs.back()));
+}
+
+/*
+** A reader takes snapshots while the owner updates: each one must be a
+** whole version, with keys 0 to size - 1.
+*/
+static void	test_concurrent_snapshots()
+{
+	imap	m;
+	bool	torn = false;
+
+	std::thread	reader([&m, &torn]() {
+		for (int i = 0; i < 2000; ++i)
+		{
+			imap	snap = m.snapshot();
+			int		expect = 0;
+
+			for (imap::const_iterator it = snap.begin(); it != snap.end(); ++it, ++expect)
+				if (it->first != expect)
+					torn = true;
+			if (static_cast<size_t>(expect) != snap.size())
+				torn = true;
+		}
+	});
+	for (int k = 0; k < 20000; ++k)
+		m.insert(ft::make_pair(k, k));
+	reader.join();
+	CHECK(!torn);
+	CHECK(m.size() == 20000);
+}
+
+static void	test_insert_throws()
+{
+	pmap				m;
+	std::map<int, int>	ref;
+
+	for (int i = 0; i < 64; ++i)
+	{
+		m.insert(ft::make_pair(2 * i, fragile(i)));
+		ref[2 * i] = i;
+	}
+
+	const pmap	snapshot(m);
+
+	for (int at = 1; at <= 8; ++at)
+	{
+		for (int k = -1; k < 130; k += 3)
+		{
+			ft::pair<int, fragile>	v(k, fragile(k));
+
+			fragile::countdown = at;
+			try
+			{
+				if (m.insert(v).second)
+					ref[k] = k;
+			}
+			catch (const std::runtime_error &) {}
+			fragile::countdown = 0;
+			CHECK(same_keys(m, ref));
+		}
+	}
+	CHECK(snapshot.size() == 64);
+}
+
+static void	test_erase_throws()
+{
+	pmap				m;
+	std::map<int, int>	ref;
+
+	for (int i = 0; i < 200; ++i)
+	{
+		m.insert(ft::make_pair(i, fragile(i)));
+		ref[i] = i;
+	}
+
+	const pmap	snapshot(m);
+
+	for (int i = 0; i < 200; ++i)
+	{
+		int	k = (i * 37) % 200;
+
+		fragile::countdown = 1 + i % 4;
+		try
+		{
+			if (m.erase(k))
+				ref.erase(k);
+		}
+		catch (const std::runtime_error &) {}
+		fragile::countdown = 0;
+		CHECK(same_keys(m, ref));
+	}
+	CHECK(snapshot.size() == 200);
+}
+
+int	main()
+{
+	test_differential();
+	test_concurrent_snapshots();
+	test_insert_throws();
+	test_erase_throws();
+	return (check_result("persistent_map"));
+}
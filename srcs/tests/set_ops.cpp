@@ -0,0 +1,71 @@
+#include <set.hpp>
+#include "check.hpp"
+
+/*
+** Set algebra whose element copies throw part way: the set stays a valid,
+** ordered tree whose size matches what iterating it yields, it keeps all
+** of its own elements, and nothing leaks.
+*/
+
+typedef ft::set<fragile>	fragile_set;
+
+static bool	consistent(const fragile_set &s)
+{
+	size_t	n = 0;
+	int		last = -1;
+
+	for (fragile_set::const_iterator it = s.begin(); it != s.end(); ++it, ++n)
+	{
+		if (it->key <= last)
+			return (false);
+		last = it->key;
+	}
+	return (n == s.size());
+}
+
+static bool	holds_range(const fragile_set &s, int first, int last, int step)
+{
+	for (int i = first; i < last; i += step)
+		if (s.find(fragile(i)) == s.end())
+			return (false);
+	return (true);
+}
+
+/*
+** Interleaved keys go through split and new_node(); keys past the end of
+** this set land in empty halves, which are filled by cloning.
+*/
+static void	test_unite(int n, int throw_at, bool interleaved, unsigned threads)
+{
+	fragile_set	a;
+	fragile_set	b;
+
+	for (int i = 0; i < n; ++i)
+	{
+		a.insert(fragile(2 * i));
+		b.insert(fragile(interleaved ? 2 * i + 1 : 2 * n + i));
+	}
+	fragile::countdown = throw_at;
+	try
+	{
+		a.set_union(b, threads);
+		CHECK(!"set_union did not throw");
+	}
+	catch (const std::runtime_error &) {}
+	fragile::countdown = 0;
+	CHECK(consistent(a));
+	CHECK(holds_range(a, 0, 2 * n, 2));
+	CHECK(a.size() > static_cast<size_t>(n) && a.size() < static_cast<size_t>(2 * n));
+	a.set_union(b, threads);
+	CHECK(consistent(a));
+	CHECK(a.size() == static_cast<size_t>(2 * n));
+}
+
+int	main()
+{
+	test_unite(100, 30, true, 1);
+	test_unite(100, 30, false, 1);
+	test_unite(20000, 5000, true, 4);
+	test_unite(20000, 5000, false, 4);
+	return (check_result("set_ops"));
+}
@@ -0,0 +1,149 @@
+#include <map>
+#include <vector>
+#include <thread>
+#include <cstdlib>
+#include <functional>
+#include <sharded_map.hpp>
+#include "check.hpp"
+
+/*
+** sharded_map against std::map: point operations, then the views, whose
+** merge of the shards must come out in the comparator's order, whole
+** or from a bound; and writers on several threads with views taken
+** meanwhile.
+*/
+
+template <class Map, class Ref>
+static bool	same_order(typename Map::const_iterator first, typename Map::const_iterator last,
+	typename Ref::const_iterator rfirst, typename Ref::const_iterator rlast)
+{
+	for (; first != last; ++first, ++rfirst)
+		if (rfirst == rlast || first->first != rfirst->first || first->second != rfirst->second)
+			return (false);
+	return (rfirst == rlast);
+}
+
+template <class Compare>
+static void	test_differential(size_t shards)
+{
+	typedef ft::sharded_map<int, int, Compare>	smap;
+	typedef std::map<int, int, Compare>			ref_map;
+
+	smap	m(shards);
+	ref_map	ref;
+
+	std::srand(5);
+	for (int round = 0; round < 30000; ++round)
+	{
+		int	k = std::rand() % 2000 - 1000;
+		int	v;
+
+		switch (std::rand() % 5)
+		{
+			case 0:
+				CHECK(m.insert(ft::make_pair(k, round)) == ref.insert(std::make_pair(k, round)).second);
+				break ;
+			case 1:
+				CHECK(m.insert_or_assign(k, round) == !ref.count(k));
+				ref[k] = round;
+				break ;
+			case 2:
+				CHECK(m.erase(k) == ref.erase(k));
+				break ;
+			case 3:
+				m.update(k, [](int &x) { x += 7; });
+				ref[k] += 7;
+				break ;
+			default:
+				CHECK(m.get(k, v) == (ref.count(k) == 1));
+				CHECK(!ref.count(k) || v == ref[k]);
+		}
+	}
+	CHECK(m.size() == ref.size());
+
+	typename smap::view	view(m);
+
+	CHECK(view.size() == ref.size());
+	CHECK((same_order<smap, ref_map>(view.begin(), view.end(), ref.begin(), ref.end())));
+	for (int k = -1100; k < 1100; k += 37)
+	{
+		CHECK((same_order<smap, ref_map>(view.lower_bound(k), view.end(), ref.lower_bound(k), ref.end())));
+		CHECK((same_order<smap, ref_map>(view.upper_bound(k), view.end(), ref.upper_bound(k), ref.end())));
+
+		int	hi = Compare()(k, k + 300) ? k + 300 : k - 300;
+
+		CHECK((same_order<smap, ref_map>(view.range(k, hi), view.end(), ref.lower_bound(k), ref.lower_bound(hi))));
+		CHECK(view.range(hi, k) == view.end());
+	}
+}
+
+/*
+** Every writer owns a slice of the keys and bumps a shared counter key;
+** a reader takes views meanwhile, which must each be sorted and agree
+** with their own size.
+*/
+static void	test_concurrent()
+{
+	ft::sharded_map<int, int>	m(8);
+	std::vector<std::thread>	writers;
+	bool						bad_view = false;
+
+	for (int t = 0; t < 4; ++t)
+	{
+		writers.push_back(std::thread([&m, t]() {
+			for (int i = 0; i < 5000; ++i)
+			{
+				m.insert(ft::make_pair(t * 100000 + i, i));
+				m.update(-1, [](int &x) { ++x; });
+				if (i % 3 == 0)
+					m.erase(t * 100000 + i / 2);
+			}
+		}));
+	}
+
+	std::thread	reader([&m, &bad_view]() {
+		for (int i = 0; i < 200; ++i)
+		{
+			ft::sharded_map<int, int>::view	view(m);
+			size_t							n = 0;
+			int								prev = -2;
+
+			for (ft::sharded_map<int, int>::const_iterator it = view.begin(); it != view.end(); ++it, ++n)
+			{
+				if (it->first <= prev)
+					bad_view = true;
+				prev = it->first;
+			}
+			if (n != view.size())
+				bad_view = true;
+		}
+	});
+	for (size_t t = 0; t < writers.size(); ++t)
+		writers[t].join();
+	reader.join();
+	CHECK(!bad_view);
+
+	int	counter = 0;
+
+	CHECK(m.get(-1, counter) && counter == 4 * 5000);
+	for (int t = 0; t < 4; ++t)
+		for (int i = 0; i < 5000; ++i)
+		{
+			bool	erased = false;
+
+			for (int j = i * 2; j <= i * 2 + 1 && j < 5000; ++j)
+				if (j % 3 == 0)
+					erased = true;
+			CHECK(m.count(t * 100000 + i) == !erased);
+		}
+}
+
+int	main()
+{
+	test_differential<std::less<int> >(1);
+	test_differential<std::less<int> >(3);
+	test_differential<std::less<int> >(16);
+	test_differential<std::greater<int> >(7);
+	test_concurrent();
+	return (check_result("sharded_map"));
+}
@@ -0,0 +1,178 @@
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <stdlib.h>
+#include <concurrent_skiplist_map.hpp>
+#include <concurrent_skiplist_set.hpp>
+#include "check.hpp"
+
+/*
+** Threads insert, erase, look up and walk a concurrent_skiplist_map at
+** once. Each thread counts the inserts and erases of its own that took
+** effect; once they are joined, the per-key sums must match what the map
+** holds. Worth running under ThreadSanitizer as well:
+**
+**	make test_skiplist TEST_FLAGS="-std=c++11 -g3 -pthread -fsanitize=thread"
+*/
+
+typedef ft::concurrent_skiplist_map<int, long>	skip_map;
+
+static const int		g_keys = 512;
+static const int		g_threads = 8;
+static const int		g_ops = 40000;
+
+static long	value_of(int key)
+{
+	return (key * 7919L);
+}
+
+/*
+** A walk may see elements come and go, but never out of order, and a
+** value always goes with its key.
+*/
+static bool	walk_is_sane(const skip_map &m)
+{
+	int	last = -1;
+
+	for (skip_map::const_iterator it = m.begin(); it != m.end(); ++it)
+	{
+		if (it->first <= last || it->second != value_of(it->first))
+			return (false);
+		last = it->first;
+	}
+	return (true);
+}
+
+static void	shared_keys(skip_map &m, std::vector<long> &balance, unsigned seed, std::atomic<int> &errors)
+{
+	for (int i = 0; i < g_ops; ++i)
+	{
+		int	key = rand_r(&seed) % g_keys;
+		int	op = rand_r(&seed) % 100;
+
+		if (op < 40)
+			balance[key] += m.insert(ft::make_pair(key, value_of(key))).second;
+		else if (op < 80)
+			balance[key] -= m.erase(key);
+		else if (op < 99)
+		{
+			skip_map::const_iterator	found = m.find(key);
+
+			if (found != m.end() && (found->first != key || found->second != value_of(key)))
+				++errors;
+		}
+		else if (!walk_is_sane(m))
+			++errors;
+	}
+}
+
+/*
+** Keys no other thread touches: every result is known in advance.
+*/
+static void	own_keys(skip_map &m, int first, unsigned seed, std::atomic<int> &errors)
+{
+	std::vector<bool>	held(g_keys / g_threads, false);
+
+	for (int i = 0; i < g_ops / 4; ++i)
+	{
+		int	slot = rand_r(&seed) % held.size();
+		int	key = first + slot;
+
+		if (rand_r(&seed) % 2)
+		{
+			if (m.insert(ft::make_pair(key, value_of(key))).second == held[slot])
+				++errors;
+			held[slot] = true;
+		}
+		else
+		{
+			if (m.erase(key) != held[slot])
+				++errors;
+			held[slot] = false;
+		}
+		if ((m.find(key) != m.end()) != held[slot])
+			++errors;
+	}
+	for (size_t slot = 0; slot < held.size(); ++slot)
+		m.erase(first + slot);
+}
+
+static void	test_stress()
+{
+	skip_map						m;
+	std::vector<std::vector<long> >	balance(g_threads, std::vector<long>(g_keys, 0));
+	std::vector<std::thread>		threads;
+	std::atomic<int>				errors(0);
+
+	for (int t = 0; t < g_threads; ++t)
+		threads.push_back(std::thread(shared_keys, std::ref(m), std::ref(balance[t]), 17u * t + 1, std::ref(errors)));
+	for (int t = 0; t < g_threads; ++t)
+		threads[t].join();
+	CHECK(errors == 0);
+
+	size_t	expected = 0;
+
+	for (int key = 0; key < g_keys; ++key)
+	{
+		long	sum = 0;
+
+		for (int t = 0; t < g_threads; ++t)
+			sum += balance[t][key];
+		CHECK(sum == 0 || sum == 1);
+		CHECK(static_cast<long>(m.count(key)) == sum);
+		expected += sum;
+	}
+	CHECK(m.size() == expected);
+	CHECK(walk_is_sane(m));
+
+	threads.clear();
+	m.clear();
+	for (int t = 0; t < g_threads; ++t)
+		threads.push_back(std::thread(own_keys, std::ref(m), t * (g_keys / g_threads), 31u * t + 5, std::ref(errors)));
+	for (int t = 0; t < g_threads; ++t)
+		threads[t].join();
+	CHECK(errors == 0);
+	CHECK(m.empty() && m.size() == 0);
+}
+
+struct either_way
+{
+	bool	descending;
+
+	either_way(bool descending = false) : descending(descending) {}
+
+	bool	operator()(int lhs, int rhs) const { return (descending ? rhs < lhs : lhs < rhs); }
+};
+
+static void	test_assign_comparator()
+{
+	ft::concurrent_skiplist_set<int, either_way>	down((either_way(true)));
+	ft::concurrent_skiplist_set<int, either_way>	up;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		down.insert(i);
+		up.insert(i);
+	}
+	up = down;
+	up.insert(42);
+	up.insert(-1);
+	CHECK(up.key_comp().descending);
+	CHECK(up.size() == 12 && *up.begin() == 42);
+
+	int	last = 43;
+
+	for (ft::concurrent_skiplist_set<int, either_way>::const_iterator it = up.begin(); it != up.end(); ++it)
+	{
+		CHECK(*it < last);
+		last = *it;
+	}
+	CHECK(up.count(5) == 1 && up.count(-1) == 1);
+}
+
+int	main()
+{
+	test_stress();
+	test_assign_comparator();
+	return (check_result("skiplist"));
+}
@@ -0,0 +1,271 @@
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <unordered_map>
+#include <unordered_map.hpp>
+#include <unordered_set.hpp>
+#include "check.hpp"
+
+/*
+** The Swiss table behind unordered_map and unordered_set, against
+** std::unordered_map: random updates, probes across tombstones, growth
+** against rebuilding at the same size, the load factor, rehash(0),
+** erasing while iterating and heterogeneous lookup.
+*/
+
+/*
+** Sends every key of a thousand to the same hash, so that probes run
+** through long chains of full and deleted slots.
+*/
+struct clumped_hash
+{
+	size_t	operator()(int k) const { return (static_cast<size_t>(k / 1000)); }
+};
+
+struct str_hash
+{
+	typedef void	is_transparent;
+
+	size_t	operator()(const char *s) const
+	{
+		size_t	h = 1469598103934665603ULL;
+
+		for (; *s; ++s)
+			h = (h ^ static_cast<unsigned char>(*s)) * 1099511628211ULL;
+		return (h);
+	}
+
+	size_t	operator()(const std::string &s) const { return ((*this)(s.c_str())); }
+};
+
+struct str_equal
+{
+	typedef void	is_transparent;
+
+	bool	operator()(const std::string &a, const std::string &b) const { return (a == b); }
+	bool	operator()(const std::string &a, const char *b) const { return (a == b); }
+	bool	operator()(const char *a, const std::string &b) const { return (a == b); }
+};
+
+template <class Map, class Ref>
+static bool	same_content(const Map &m, const Ref &ref)
+{
+	size_t	n = 0;
+
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it, ++n)
+	{
+		typename Ref::const_iterator	r = ref.find(it->first);
+
+		if (r == ref.end() || r->second != it->second)
+			return (false);
+	}
+	return (n == ref.size() && m.size() == ref.size());
+}
+
+template <class Hash>
+static void	test_differential(int range)
+{
+	ft::unordered_map<int, int, Hash>	m;
+	std::unordered_map<int, int>		ref;
+
+	std::srand(7);
+	for (int round = 0; round < 100000; ++round)
+	{
+		int	k = std::rand() % range;
+
+		switch (std::rand() % 4)
+		{
+			case 0:
+			case 1:
+				CHECK(m.insert(ft::make_pair(k, round)).second == ref.insert(std::make_pair(k, round)).second);
+				break ;
+			case 2:
+				CHECK(m.erase(k) == ref.erase(k));
+				break ;
+			default:
+				CHECK((m.find(k) == m.end()) == (ref.find(k) == ref.end()));
+		}
+	}
+	CHECK(same_content(m, ref));
+	for (int k = 0; k < range; ++k)
+		CHECK(m.count(k) == ref.count(k));
+}
+
+/*
+** Erasing leaves tombstones that lookups must probe past, and that a table
+** out of room clears by rebuilding at the same size when they take up
+** most of it; with few of them it doubles instead.
+*/
+static void	test_tombstones()
+{
+	ft::unordered_map<int, int, clumped_hash>	m;
+
+	m.reserve(100);
+
+	const size_t	buckets = m.bucket_count();
+	int				next = 0;
+
+	while (m.bucket_count() == buckets && m.load_factor() < 0.85f)
+	{
+		m.insert(ft::make_pair(next, next));
+		++next;
+	}
+	CHECK(m.bucket_count() == buckets);
+	for (int k = 0; k < next; ++k)
+		if (k % 8)
+			m.erase(k);
+	for (int k = 0; k < next; ++k)
+		CHECK(m.count(k) == (k % 8 == 0));
+	for (int k = 0; k < 5 * next; ++k)
+	{
+		m.insert(ft::make_pair(100000 + k, k));
+		m.erase(100000 + k);
+	}
+	CHECK(m.bucket_count() == buckets);
+	for (int k = 0; k < next; ++k)
+		CHECK(m.count(k) == (k % 8 == 0));
+	while (m.bucket_count() == buckets)
+	{
+		m.insert(ft::make_pair(next, next));
+		++next;
+	}
+	CHECK(m.bucket_count() == 2 * buckets + 1);
+	for (int k = 0; k < next; ++k)
+		CHECK(m.find(k) == m.end() || m.find(k)->second == k);
+}
+
+static void	test_load_factor()
+{
+	ft::unordered_map<int, int>	m;
+
+	m.max_load_factor(0.5f);
+	CHECK(m.max_load_factor() == 0.5f);
+	for (int k = 0; k < 10000; ++k)
+	{
+		m.insert(ft::make_pair(k, k));
+		CHECK(m.load_factor() <= 0.5f);
+	}
+	m.max_load_factor(0.9f);
+	CHECK(m.load_factor() <= 0.9f && m.size() == 10000);
+	m.max_load_factor(2.f);
+	CHECK(m.max_load_factor() == 0.9375f);
+	m.max_load_factor(0.01f);
+	CHECK(m.max_load_factor() == 0.125f);
+	CHECK(m.load_factor() <= 0.125f && m.size() == 10000);
+	for (int k = 0; k < 10000; ++k)
+		CHECK(m.at(k) == k);
+}
+
+static void	test_rehash()
+{
+	ft::unordered_map<int, int>	m;
+
+	m.rehash(1000);
+	CHECK(m.bucket_count() >= 1000);
+	m.rehash(0);
+	CHECK(m.bucket_count() == 0 && m.empty());
+	for (int k = 0; k < 1000; ++k)
+		m.insert(ft::make_pair(k, k));
+	m.rehash(100000);
+
+	const size_t	big = m.bucket_count();
+
+	m.rehash(0);
+	CHECK(m.bucket_count() < big && m.load_factor() <= m.max_load_factor());
+	for (int k = 0; k < 1000; ++k)
+		CHECK(m.at(k) == k);
+	m.clear();
+	m.rehash(0);
+	CHECK(m.bucket_count() == 0);
+	m.insert(ft::make_pair(1, 1));
+	CHECK(m.size() == 1 && m.at(1) == 1);
+}
+
+static void	test_erase_while_iterating()
+{
+	ft::unordered_map<int, int>		m;
+	std::unordered_map<int, int>	ref;
+
+	for (int k = 0; k < 5000; ++k)
+	{
+		m.insert(ft::make_pair(k, k));
+		ref[k] = k;
+	}
+
+	size_t	seen = 0;
+
+	for (ft::unordered_map<int, int>::iterator it = m.begin(); it != m.end(); ++seen)
+	{
+		if (it->first % 3)
+		{
+			ref.erase(it->first);
+			it = m.erase(it);
+		}
+		else
+			++it;
+	}
+	CHECK(seen == 5000);
+	CHECK(same_content(m, ref));
+}
+
+static void	test_heterogeneous()
+{
+	ft::unordered_map<std::string, int, str_hash, str_equal>	m;
+	ft::unordered_set<std::string, str_hash, str_equal>			s;
+
+	for (int k = 0; k < 1000; ++k)
+	{
+		m.insert(ft::make_pair(std::string(1 + k % 7, 'a' + k % 26) + std::to_string(k), k));
+		s.insert(std::to_string(k));
+	}
+	CHECK(m.find("aaa28") == m.end());
+	CHECK(m.find("ccc2") != m.end() && m.find("ccc2")->second == 2);
+	CHECK(m.count("bb1") == 1 && m.count("bb2") == 0);
+	CHECK(m.equal_range("bb1").first != m.end());
+	CHECK(s.count("999") == 1 && s.count("1000") == 0);
+	CHECK(s.find("42") != s.end() && *s.find("42") == "42");
+}
+
+/*
+** The mapped value passed to try_emplace() or insert_or_assign() may be
+** an element of the map, including when the insert grows the table.
+*/
+static void	test_aliasing()
+{
+	ft::unordered_map<int, std::string>	m;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		m.try_emplace(i, std::string(40, 'a' + i % 26));
+		if (i % 2)
+		{
+			CHECK(m.try_emplace(10000 + i, m.at(i - 1)).second);
+			CHECK(m.at(10000 + i) == m.at(i - 1));
+		}
+		else
+		{
+			CHECK(m.insert_or_assign(10000 + i, m.at(i)).second);
+			CHECK(m.at(10000 + i) == m.at(i));
+		}
+	}
+	CHECK(m.size() == 4000);
+	CHECK(!m.insert_or_assign(10000, m.at(1)).second);
+	CHECK(m.at(10000) == m.at(1));
+}
+
+int	main()
+{
+	test_differential<std::hash<int> >(5000);
+	test_differential<clumped_hash>(5000);
+	test_tombstones();
+	test_load_factor();
+	test_rehash();
+	test_erase_while_iterating();
+	test_heterogeneous();
+	test_aliasing();
+#if defined(__SSE2__)
+	return (check_result("unordered_map"));
+#else
+	return (check_result("unordered_map (portable groups)"));
+#endif
+}
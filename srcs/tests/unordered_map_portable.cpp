@@ -0,0 +1,6 @@
+/*
+** unordered_map.cpp again over the portable group code, the one targets
+** without SSE2 get.
+*/
+#undef __SSE2__
+#include "unordered_map.cpp"